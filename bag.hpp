@@ -3,37 +3,49 @@
  *
  * Bag is an implementation of a set-like data structure.
  * It provides fast (O(1)) add, remove and pick operations.
- * It stores integer values less than N.
+ * It stores integer values less than the Pool capacity of T.
  *
  ****/
  #pragma once  // Prevents multiple inclusions
  // Comment: Standard header guard; docstring outlines Bag’s purpose (Sec. 3.1.2).
- 
+
  #include <cassert>       // For assert() in add(), remove(), pick()
- #include <random>        // For std::default_random_engine, uniform_int_distribution
- 
+ #include <atomic>        // For the lock-free contains()/size() reads
+ #include <mutex>         // For std::mutex guarding add()/remove()
+ #include <vector>        // For the capacity-sized indices/elements arrays
+ #include "rng.hpp"       // For Xoshiro256pp (batched RNG, Sec. 2.1)
+ #include "pool.hpp"      // For Pool<T>::pool_capacity() sizing
+
  // Comment: Bag manages a set of Labels with O(1) operations for Monte Carlo moves (Sec. 3.1.2).
- template <class T, unsigned int N>  // T: Type with Label (e.g., Vertex), N: Max size
+ template <class T>  // T: Pool-derived type with Label (e.g., Vertex)
  class Bag {
 	 using Label = typename T::Label;  // Alias for T’s Label type (e.g., Vertex::Label)
 	 // Comment: Ensures Bag works with Pool-derived types (Sec. 3.1.1).
- 
+
  private:
-	 std::array<int, N> indices;    // Maps Labels to positions in elements; contains holes
-	 std::array<Label, N> elements; // Contiguous list of active Labels
-	 unsigned int capacity_;        // Maximum size (N)
-	 unsigned int size_;            // Current number of elements
-	 std::default_random_engine &rng;  // Reference to external RNG
+	 std::vector<std::atomic<int>> indices;  // Maps Labels to positions in elements; contains holes
+	 std::vector<Label> elements;            // Contiguous list of active Labels
+	 unsigned int capacity_;                 // Maximum size (the Pool capacity of T)
+	 std::atomic<unsigned int> size_;        // Current number of elements
+	 Xoshiro256pp &rng;           // Reference to external RNG
+	 std::mutex mtx;              // Guards add()/remove() under the parallel sweep engine
 	 // Comment: Core data structures (Sec. 3.1.2); indices tracks positions, elements holds values.
- 
+	 // Sized at construction from the run-time Pool capacity, so the config-file pool
+	 // keys govern these arrays too instead of the old compile-time constants.
+	 // Mutators run under mtx, but contains() and size() are read lock-free on the
+	 // move hot path (also from other sweep threads), so the slots they read are
+	 // atomic ints: word-sized loads, free on x86, and defined behavior under races.
+
 	 enum : int {
 		 EMPTY = -1  // Marker for unused slots
 	 };
 	 // Comment: Defines EMPTY as -1; could be constexpr but enum suffices.
- 
+
  public:
-	 explicit Bag(std::default_random_engine &rng) : capacity_(N), size_(0), rng(rng) {
-		 indices.fill(EMPTY);  // Initialize indices with EMPTY
+	 explicit Bag(Xoshiro256pp &rng)
+		 : indices(Pool<T>::pool_capacity()), elements(Pool<T>::pool_capacity()),
+		   capacity_(indices.size()), size_(0), rng(rng) {
+		 for (auto &ix : indices) ix = EMPTY;  // atomics value-initialize to 0, not EMPTY
 	 }
 	 // Comment: Constructor sets up empty Bag with RNG reference (e.g., from Universe).
  
@@ -48,33 +60,41 @@
 	 // Comment: O(1) check using indices array (Sec. 3.1.2).
  
 	 void add(Label obj) {  // Adds a Label to Bag
+		 std::lock_guard<std::mutex> lock(mtx);  // Structure is shared between sweep threads
 		 assert(!contains(obj));  // Ensure not already present
 		 indices[obj] = size_;    // Map Label to current size
 		 elements[size_] = obj;   // Add Label to end
 		 size_++;                 // Increment size
 	 }
 	 // Comment: O(1) insertion; appends to elements, updates indices (Sec. 3.1.2).
- 
+
 	 void remove(Label obj) {  // Removes a Label from Bag
+		 std::lock_guard<std::mutex> lock(mtx);  // Structure is shared between sweep threads
 		 assert(contains(obj));   // Ensure present
 		 size_--;                 // Decrement size
- 
-		 auto index = indices[obj];  // Position of obj in elements
+
+		 int index = indices[obj];   // Position of obj in elements (plain copy of the atomic)
 		 auto last = elements[size_]; // Last element
- 
+
 		 elements[index] = last;  // Move last to fill hole
 		 elements[size_] = EMPTY; // Clear last slot (though not strictly needed)
 		 indices[last] = index;   // Update last’s index
 		 indices[obj] = EMPTY;    // Mark obj’s slot as free
 	 }
 	 // Comment: O(1) removal; swaps with last element (Sec. 3.1.2).
- 
+
 	 Label pick() const {  // Randomly selects a Label
 		 assert(size_ > 0);  // Ensure not empty
-		 std::uniform_int_distribution<> uniform(0, size_ - 1);
-		 return elements[uniform(rng)];  // Return random element
+		 return elements[rng.bounded(size_)];  // Return random element (Lemire bound)
 	 }
 	 // Comment: O(1) random selection; used in Monte Carlo moves (Sec. 2.3).
+
+	 Label pick(Xoshiro256pp &gen) const {  // Selection with a caller-supplied RNG
+		 assert(size_ > 0);  // Ensure not empty
+		 return elements[gen.bounded(size_)];  // Return random element (Lemire bound)
+	 }
+	 // Comment: Same as pick(), but draws from an explicit engine so each sweep thread
+	 // (and each replica) can use its own stream instead of the shared member rng.
  
 	 void log() {  // Debug logging
 		 // printf("indices\n");  // Commented out; would log indices array
@@ -96,6 +116,6 @@
  };
  
  // HPC Targets Summary:
- // [General #10]: Fixed N aids cache but limits size; pre-allocation of indices/elements is optimal.
+ // [General #10]: Capacity-sized arrays follow the configured Pool ceiling; pre-allocation of indices/elements is optimal.
  // [GPU #7]: pick() could be GPU-accelerated for bulk random selections in Monte Carlo moves.
  // [OpenMP #3, GPU #8]: No direct BFS here, but usage in Observable BFS could benefit indirectly.
\ No newline at end of file
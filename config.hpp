@@ -3,7 +3,9 @@
 // Comment: Standard header guard.
 
 #include <fstream>       // For std::ifstream to read config file
+#include <sstream>       // For splitting comma-separated scan lists
 #include <string>        // For std::string (keys, values, filename)
+#include <vector>        // For the scan list getters
 #include <cassert>       // For assert() to enforce required keys
 #include <unordered_map> // For std::unordered_map to store key-value pairs
 
@@ -13,6 +15,13 @@ public:
     void read(std::string fname) {  // Reads config file into dictionary
         std::ifstream infile(fname);  // Open file
         assert(infile.is_open());     // Ensure file opened successfully
+        parse(infile);
+    }
+    // Comment: Split from parse() so the MPI ensemble driver (main.cpp) can broadcast
+    // the bytes rank 0 read and have every other rank parse without touching the
+    // filesystem.
+
+    void parse(std::istream &infile) {  // Parses an already-opened config stream
         std::string key, value;
 
         while (infile >> key >> value) {  // Read key-value pairs
@@ -46,6 +55,11 @@ public:
     }
     // Comment: Converts string value to int (e.g., "seed", "thermalsweeps").
 
+    int getInt(std::string key, int fallback) {  // Retrieves optional integer value
+        return dict.find(key) != dict.end() ? std::stoi(dict[key]) : fallback;
+    }
+    // Comment: For keys not enforced in read() (e.g., "threads"); old configs stay valid.
+
     double getDouble(std::string key) {  // Retrieves double value
         return std::stod(dict[key]);
     }
@@ -56,6 +70,32 @@ public:
     }
     // Comment: Returns string as-is (e.g., "outputdir", "fileid").
 
+    std::string getString(std::string key, std::string fallback) {  // Retrieves optional string value
+        return dict.find(key) != dict.end() ? dict[key] : fallback;
+    }
+    // Comment: Same convention as the getInt() fallback overload (e.g., "tracefile").
+
+    std::vector<double> getDoubleList(std::string key) {  // Optional comma-separated doubles
+        std::vector<double> values;
+        if (dict.find(key) == dict.end()) return values;
+        std::stringstream ss(dict[key]);
+        std::string item;
+        while (std::getline(ss, item, ',')) values.push_back(std::stod(item));
+        return values;
+    }
+    // Comment: For scan keys (e.g., "k0scan 2.0,3.0,4.0"); an absent key gives an
+    // empty list, so plain configs behave exactly as before.
+
+    std::vector<int> getIntList(std::string key) {  // Optional comma-separated integers
+        std::vector<int> values;
+        if (dict.find(key) == dict.end()) return values;
+        std::stringstream ss(dict[key]);
+        std::string item;
+        while (std::getline(ss, item, ',')) values.push_back(std::stoi(item));
+        return values;
+    }
+    // Comment: Same convention as getDoubleList() (e.g., "seedscan 1,2,3").
+
 private:
     std::unordered_map<std::string, std::string> dict;  // Stores key-value pairs
     // Comment: Hash map for efficient lookup (Sec. 3).
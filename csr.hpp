@@ -0,0 +1,58 @@
+// Copyright 2021 Joren Brunekreef, Daniel Nemeth and Andrzej Görlich
+/****
+ *
+ * FlatAdjacency stores an adjacency structure in CSR form: one flat
+ * offsets array plus one packed array of neighbor labels. BFS loops
+ * then stream through contiguous memory instead of chasing a pointer
+ * per vertex into a separately-allocated heap block. The structure is
+ * rebuilt in a single linear pass from per-vertex staging vectors,
+ * which remain the mutable build-time representation.
+ *
+ ****/
+#pragma once  // Prevents multiple inclusions
+// Comment: Standard header guard; docstring outlines the CSR layout (Sec. 3.2.2).
+
+#include <vector>     // For the offsets and packed label arrays
+#include <algorithm>  // For std::copy in build()
+
+// Comment: CSR adjacency for BFS traversals; L is a Pool Label type (Sec. 3.1.1).
+template <class L>
+class FlatAdjacency {
+private:
+    std::vector<int> offsets;  // offsets[i]..offsets[i+1] indexes i's neighbors in labels
+    std::vector<L> labels;     // All neighbor labels, packed back to back
+
+public:
+    class Range {  // Lightweight view of one label's neighbor run
+    public:
+        Range(const L *begin_, const L *end_) : b(begin_), e(end_) {}
+        const L *begin() const { return b; }
+        const L *end() const { return e; }
+        int size() const { return e - b; }
+
+    private:
+        const L *b;  // First neighbor
+        const L *e;  // One past the last neighbor
+    };
+    // Comment: Supports range-for like the staging std::vector did (Sec. 3.4).
+
+    Range operator[](int i) const {
+        return Range(labels.data() + offsets[i], labels.data() + offsets[i + 1]);
+    }
+
+    void build(const std::vector<std::vector<L>> &staging) {  // One-pass repack
+        offsets.resize(staging.size() + 1);
+        offsets[0] = 0;
+        for (size_t i = 0; i < staging.size(); i++)  // Prefix-sum the degrees
+            offsets[i + 1] = offsets[i] + staging[i].size();
+
+        labels.resize(offsets.back());
+        for (size_t i = 0; i < staging.size(); i++)  // Pack neighbor runs contiguously
+            std::copy(staging[i].begin(), staging[i].end(), labels.begin() + offsets[i]);
+    }
+    // Comment: Linear in the total adjacency size; no per-vertex allocations.
+};
+
+// HPC Targets Summary:
+// [General #10]: Contiguous neighbor runs remove the cache misses of nested vectors.
+// [OpenMP #3, GPU #8]: Flat arrays are the natural BFS layout for threads and GPUs.
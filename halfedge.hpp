@@ -14,9 +14,9 @@ class HalfEdge : public Pool<HalfEdge> {  // Inherits from Pool for efficient ma
 // Comment: Manages half-edges, which are edges of spatial triangles in (3,1)-tetrahedra (Sec. 3.2.2).
 
 public:
-    static const unsigned pool_size = 5000000;  // Maximum number of half-edges in Pool
-    // Comment: Defines capacity C (Sec. 3.1.1), set to 5 million; limits system size.
-    // HPC Target [General #10]: Fixed size aids cache but could be dynamic for scalability.
+    static const unsigned pool_size = 5000000;  // Default half-edge capacity (Sec. 3.1.1)
+    // Comment: Used when the config file sets no "maxhalfedges" key; Pool storage is
+    // chunked and demand-allocated.
 
     std::array<Pool<Vertex>::Label, 2> vs = {-1, -1};  // Two vertex labels (start, end)
     // Comment: Represents directed edge endpoints; initialized to -1 (invalid).
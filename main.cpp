@@ -1,4 +1,12 @@
 // Copyright 2021 Joren Brunekreef, Daniel Nemeth and Andrzej Görlich
+#include <thread>            // For the replica driver (one engine per thread)
+#include <fstream>           // For the checkpoint-geometry existence probe
+#include <memory>            // For std::unique_ptr holding each replica's Universe
+#ifdef CDT_MPI
+#include <mpi.h>             // Ensemble driver: one allocation runs a whole (k0, k3, seed) scan
+#include <sstream>           // For the config broadcast and the per-point block headers
+#include <algorithm>         // For the seed-stride computation (min/max_element)
+#endif
 #include "config.hpp"        // Configuration file reader
 #include "universe.hpp"      // Manages the CDT triangulation state
 #include "simulation.hpp"    // Controls Monte Carlo simulation workflow
@@ -6,22 +14,9 @@
 #include "observables/volume_profile.hpp"  // Observable for volume distribution
 #include "observables/ricci2d.hpp"         // 2D Ricci curvature observable (note: unexpected in 3D context)
 
-std::default_random_engine rng(1);  // Global random number generator with fixed seed 1
-// Comment: Provides randomness for Monte Carlo moves (Sec. 2.1 of paper). Fixed seed ensures reproducibility.
-// HPC Target [MPI #4]: Static RNG needs per-rank instances for distributed runs to avoid identical sequences.
-
-int main(int argc, const char * argv[]) {
-    std::string fname;
-    if (argc > 1) {
-        fname = std::string(argv[1]);  // Read config file name from command line argument
-        printf("%s\n", fname.c_str()); // Print config file name
-    }
-    // Comment: Allows user to specify config file via command line (e.g., ./main config.txt).
-    // HPC Target [General #10]: Minimal I/O impact here, but consider buffered output for large runs.
-
-    ConfigReader cfr;              // Object to parse configuration file
-    cfr.read(fname);               // Load parameters from file
+static int mpiRank = 0, mpiSize = 1;  // Process identity; set once in main(), 0/1 in serial builds
 
+static void runConfig(ConfigReader &cfr) {  // One full campaign job: parse-to-finish for one config
     // Read simulation parameters from config file (Sec. 3.3 of paper)
     double k0 = cfr.getDouble("k0");              // Gravitational coupling (Sec. 2.3)
     double k3_s = cfr.getDouble("k3");            // Cosmological coupling (Sec. 2.3)
@@ -41,47 +36,222 @@ int main(int argc, const char * argv[]) {
     int v3 = cfr.getInt("v3");                    // Custom parameter
     std::string inFile = cfr.getString("infile"); // Input triangulation file
     std::string outFile = cfr.getString("outfile"); // Output file for results
+    int threads = cfr.getInt("threads", 1);       // Sweep threads per replica (optional; 1 = serial)
+    int pipeline = cfr.getInt("pipeline", 0);     // Overlap measurement with the next sweep (optional)
+    int proposalBatch = cfr.getInt("proposalbatch", 0);  // Proposals pre-drawn per batch (optional; see simulation.hpp)
+    int replicas = cfr.getInt("replicas", 1);     // Independent replicas in this process (optional)
+    int resume = cfr.getInt("resume", 0);         // Continue from a checkpoint (optional; see simulation.hpp)
+    int autotune = cfr.getInt("autotune", 0);     // Secant k3 controller + early thermal exit (optional)
+    std::string traceFile = cfr.getString("tracefile", "");   // Record accepted moves (optional; see simulation.hpp)
+    std::string replayFile = cfr.getString("replayfile", ""); // Replay a trace instead of running Monte Carlo (optional)
     // Comment: Parameters configure simulation per Sec. 3 of paper. 'v1-v3' unclear without code context; possibly move-specific.
 
+    Pool<Vertex>::reserve(cfr.getInt("maxvertices", Vertex::pool_size));     // Pool ceilings (optional)
+    Pool<Tetra>::reserve(cfr.getInt("maxtetras", Tetra::pool_size));
+    Pool<HalfEdge>::reserve(cfr.getInt("maxhalfedges", HalfEdge::pool_size));
+    Pool<Triangle>::reserve(cfr.getInt("maxtriangles", Triangle::pool_size));
+    // Comment: One arena per type, shared by all replicas, so the ceilings are set once
+    // here before any Universe exists. Chunks are backed on demand, so a generous
+    // ceiling on a big-memory node and a tight one in a small container use the same
+    // binary; unset keys fall back to the historical compile-time sizes.
+
     printf("fID: %s\n", fID.c_str());    // Print file ID
     printf("seed: %d\n", seed);          // Print seed
     printf("strictness: %d\n", strictness); // Print strictness level
     // Comment: Diagnostic output for key parameters.
 
     Observable::data_dir = outputDir;    // Set output directory for observables (Sec. 3.4)
-    // Comment: Static member suggests shared state across observables; potential concurrency issue.
-
-    Universe::initialize(inFile, fID, strictness, volfixSwitch);
-    // Comment: Sets up initial triangulation state (Sec. 3). Reads from 'inFile' if provided, enforces manifold properties.
-    // HPC Target [General #10]: Initialization could pre-allocate memory (e.g., Pool capacity) for cache efficiency.
-
-    printf("\n\n#######################\n");
-    printf("* * * Initialized * * *\n");  // Status message
-    printf("#######################\n\n");
-
-    VolumeProfile vp3(fID);              // Observable for 3D volume profile (Sec. 3.4)
-    Simulation::addObservable3d(vp3);    // Register with 3D simulation
-    // Comment: Tracks volume distribution across time slices (S^1 x S^2 topology in Sec. 2.3).
-
-    Ricci2d ricci2d(fID);                // Observable for 2D Ricci curvature
-    Simulation::addObservable2d(ricci2d); // Register with 2D simulation (unexpected in 3D context)
-    // Comment: Appears to be a mismatch; paper focuses on 3D CDT (Sec. 2.3), but 'Ricci2d' suggests 2D observable.
-    // Potential Bug: Should this be a 3D Ricci observable? Verify against codebase intent.
-
-    Simulation::start(k0, k3_s, sweeps, thermalSweeps, kSteps, targetVolume, target2Volume, seed, outFile, v1, v2, v3);
-    // Comment: Runs full simulation: tuning (Sec. 3.3.1), thermalization (Sec. 3.3.2), and measurement (Sec. 3.3.3).
-    // HPC Targets:
-    // [OpenMP #1]: Parallelize sweeps within 'start()' (e.g., lines 97-105 in HPC plan).
-    // [MPI #4]: Distribute independent runs across nodes here.
-    // [GPU #7]: Accelerate move attempts in sweeps.
-    // [General #12]: Tune sweep size dynamically based on acceptance rates.
-
-    printf("\n\n####################\n");
-    printf("* * * Finished * * *\n");  // Status message
-    printf("####################\n\n");
-
-    printf("t31: %d\n", Universe::tetras31.size()); // Print number of (3,1)-tetrahedra
-    // Comment: Diagnostic output for triangulation state (Sec. 2.3). Useful for verifying volume fixing.
+    // Comment: Shared by all replicas; file names stay distinct through the fID suffix.
+    Observable::flush_every = cfr.getInt("flushevery", 64);  // Measurements per file append (optional)
+    // Comment: Buffered observable output (observable.cpp); 1 restores line-at-a-time writes.
+
+    auto runReplica = [&](int r, double k0p, double k3p, int seedp, std::string pID,
+                          std::string pOutFile, std::string scanHeader) {
+        // One full engine lifetime: initialize, run, report
+        std::string rID = replicas > 1 ? pID + "-r" + std::to_string(r) : pID;
+        std::string rOutFile = (replicas > 1 && pOutFile != "") ? pOutFile + "-r" + std::to_string(r) : pOutFile;
+        // Comment: Replica outputs are suffixed so ensembles never clobber each other.
+
+        std::string rInFile = inFile;
+        if (resume) {  // Prefer the checkpoint geometry when one exists for this replica
+            std::string ckptGeom = Simulation::checkpointGeometryFile(rOutFile);
+            if (std::ifstream(ckptGeom).good()) rInFile = ckptGeom;
+        }
+        // Comment: The matching simulation state (couplings, rngs, sweep index) is
+        // restored by Simulation::start(); without a checkpoint the run starts fresh.
+
+        auto universe = std::unique_ptr<Universe>(new Universe());  // Heap: the Bags are large fixed arrays
+        universe->initialize(rInFile, rID, strictness, volfixSwitch);
+        universe->checkMode = cfr.getInt("checkmode", 0);        // Tiered consistency checking (universe.hpp)
+        universe->checkSampleSize = cfr.getInt("checksample", 64);  // Tetras per sweep in sampled mode
+        if (universe->checkMode) universe->runChecks(3);  // Full pass once: catches a bad geometry import
+        // Comment: Sets up this replica's triangulation (Sec. 3); replicas share only the Pool arena.
+        // HPC Target [General #10]: Initialization could pre-allocate memory (e.g., Pool capacity) for cache efficiency.
+
+        printf("\n\n#######################\n");
+        printf("* * * Initialized * * *\n");  // Status message
+        printf("#######################\n\n");
+
+        Simulation simulation(*universe);    // Monte Carlo engine bound to this replica
+        simulation.nThreads = threads;       // Enable slab-parallel sweeps when threads > 1
+        simulation.proposalBatch = proposalBatch;  // Batched proposal generation in serial sweeps
+        simulation.pipeline = pipeline != 0; // Measure on the pool while the next sweep runs
+        simulation.resume = resume != 0;     // Restore checkpointed state in start() when present
+        simulation.autotune = autotune != 0; // Fit d<N>/dk3 instead of the tuning ladder
+        simulation.traceFile = (traceFile != "" && replicas > 1) ? traceFile + "-r" + std::to_string(r) : traceFile;
+        // Comment: Replica traces get the same -r suffix as the other outputs.
+        // Comment: performSweep() falls back to the serial loop if the S^1 direction is too short.
+
+        VolumeProfile vp3(rID, *universe, simulation);  // Observable for 3D volume profile (Sec. 3.4)
+        simulation.addObservable3d(vp3);     // Register with 3D simulation
+        // Comment: Tracks volume distribution across time slices (S^1 x S^2 topology in Sec. 2.3).
+
+        Ricci2d ricci2d(rID, *universe, simulation);  // Observable for 2D Ricci curvature
+        simulation.addObservable2d(ricci2d); // Register with 2D simulation (unexpected in 3D context)
+        // Comment: Appears to be a mismatch; paper focuses on 3D CDT (Sec. 2.3), but 'Ricci2d' suggests 2D observable.
+        // Potential Bug: Should this be a 3D Ricci observable? Verify against codebase intent.
+
+        if (scanHeader != "") {  // Scan mode: attribute the next block in the aggregated per-rank files
+            for (Observable *obs : std::initializer_list<Observable *>{&vp3, &ricci2d}) {
+                std::ofstream hdr(obs->outputFile(), std::ios::app);
+                hdr << scanHeader << "\n";
+            }
+        }
+        // Comment: On resume the duplicate header lands past the checkpointed file
+        // length and Observable::loadState() truncates it away with the stale data.
+
+        simulation.start(k0p, k3p, sweeps, thermalSweeps, kSteps, targetVolume, target2Volume, seedp + r, rOutFile, v1, v2, v3);
+        // Comment: Runs full simulation: tuning (Sec. 3.3.1), thermalization (Sec. 3.3.2), and measurement (Sec. 3.3.3).
+        // Replica r offsets the seed by r so the ensemble samples independent streams.
+        // HPC Targets:
+        // [OpenMP #1]: Parallelize sweeps within 'start()' (e.g., lines 97-105 in HPC plan).
+        // [MPI #4]: Distribute independent runs across nodes here.
+        // [GPU #7]: Accelerate move attempts in sweeps.
+        // [General #12]: Tune sweep size dynamically based on acceptance rates.
+
+        printf("\n\n####################\n");
+        printf("* * * Finished * * *\n");  // Status message
+        printf("####################\n\n");
+
+        printf("t31: %d\n", universe->tetras31.size()); // Print number of (3,1)-tetrahedra
+        // Comment: Diagnostic output for triangulation state (Sec. 2.3). Useful for verifying volume fixing.
+    };
+
+    auto runPoint = [&](double k0p, double k3p, int seedp, std::string pID,
+                        std::string pOutFile, std::string scanHeader) {
+        if (replicas == 1) {
+            runReplica(0, k0p, k3p, seedp, pID, pOutFile, scanHeader);  // Single run: main thread
+        } else {
+            std::vector<std::thread> ensemble;  // One engine per thread, sharing only the binary and Pool arena
+            for (int r = 0; r < replicas; r++)
+                ensemble.emplace_back(runReplica, r, k0p, k3p, seedp, pID, pOutFile, scanHeader);
+            for (auto &t : ensemble) t.join();
+            // Comment: Amortizes process startup (including the Pool allocations) over the
+            // whole replica ensemble instead of one scheduler job per run.
+        }
+    };
+
+    if (replayFile != "") {  // Trace replay mode: rebuild a recorded geometry, no Monte Carlo
+        auto universe = std::unique_ptr<Universe>(new Universe());
+        universe->initialize(inFile, fID, strictness, volfixSwitch);  // Same input the recording run started from
+        Simulation simulation(*universe);
+        simulation.targetVolume = targetVolume;    // Observables read these (e.g. Minbu's
+        simulation.target2Volume = target2Volume;  // slice selection), the tuner does not run
+        VolumeProfile vp3(fID, *universe, simulation);
+        simulation.addObservable3d(vp3);
+        Ricci2d ricci2d(fID, *universe, simulation);
+        simulation.addObservable2d(ricci2d);
+        simulation.replay(replayFile);  // Apply the trace, then time updateGeometry() and one measurement pass
+        return;
+        // Comment: Replay skips rng, acceptance tests and rejected proposals, so a
+        // long run's geometry is rebuilt in a small fraction of its wall time —
+        // bit-identical vertex/tetra state for benchmarking across code revisions.
+    }
+
+#ifdef CDT_MPI
+    // Scan driver (MPI build): the optional k0scan/k3scan/seedscan keys define a grid
+    // of runs and ranks take points round-robin, so one scheduler allocation covers
+    // the whole parameter scan instead of one job (and one full startup) per point.
+    std::vector<double> k0Scan = cfr.getDoubleList("k0scan");
+    std::vector<double> k3Scan = cfr.getDoubleList("k3scan");
+    std::vector<int> seedScan = cfr.getIntList("seedscan");
+    if (k0Scan.empty()) k0Scan.push_back(k0);    // Absent axes collapse to the scalar keys,
+    if (k3Scan.empty()) k3Scan.push_back(k3_s);  // so a plain config runs one point on rank 0
+    if (seedScan.empty()) seedScan.push_back(seed);
+
+    int nSeeds = seedScan.size();
+    int nPoints = k0Scan.size() * k3Scan.size() * nSeeds;
+    int seedStride = *std::max_element(seedScan.begin(), seedScan.end())
+                   - *std::min_element(seedScan.begin(), seedScan.end()) + 1;
+    // Comment: Each (k0, k3) cell shifts the seed axis into a disjoint interval, so no
+    // two grid points seed an engine identically and the splitmix64-expanded streams
+    // (rng.hpp) stay non-overlapping across ranks.
+
+    for (int p = mpiRank; p < nPoints; p += mpiSize) {
+        int cell = p / nSeeds;  // (k0, k3) cell index; seed is the fastest axis
+        double k0p = k0Scan[cell / k3Scan.size()];
+        double k3p = k3Scan[cell % k3Scan.size()];
+        int seedp = seedScan[p % nSeeds] + cell * seedStride;
+
+        std::string pID = fID + "-n" + std::to_string(mpiRank);  // Aggregated per-rank data files
+        std::string pOutFile = outFile == "" ? "" : outFile + "-p" + std::to_string(p);
+        // Comment: Geometry/checkpoint files stay per-point, but observable output
+        // appends into one file per observable per rank instead of one per grid
+        // point, cutting the shared-filesystem load of a wide scan.
+
+        std::ostringstream header;
+        header << "# point " << p << " k0 " << k0p << " k3 " << k3p << " seed " << seedp;
+        printf("[rank %d] point %d: k0 %g k3 %g seed %d\n", mpiRank, p, k0p, k3p, seedp);
+
+        runPoint(k0p, k3p, seedp, pID, pOutFile, nPoints > 1 ? header.str() : "");
+    }
+#else
+    runPoint(k0, k3_s, seed, fID, outFile, "");
+#endif
+}
+
+int main(int argc, const char * argv[]) {
+#ifdef CDT_MPI
+    MPI_Init(NULL, NULL);          // argv is const-qualified here; MPI accepts NULLs
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+    for (int a = 1; a < argc; a++) {  // Batch mode: every argument is a config, run in order
+        std::string fname(argv[a]);
+        printf("%s\n", fname.c_str()); // Print config file name
+
+        ConfigReader cfr;              // Object to parse configuration file
+#ifdef CDT_MPI
+        std::string cfgText;           // Rank 0 reads the config once and broadcasts the
+        if (mpiRank == 0) {            // bytes, so a wide launch opens each file one time
+            std::ifstream cfgFile(fname);
+            std::stringstream ss;
+            ss << cfgFile.rdbuf();
+            cfgText = ss.str();
+        }
+        long cfgLen = cfgText.size();
+        MPI_Bcast(&cfgLen, 1, MPI_LONG, 0, MPI_COMM_WORLD);
+        cfgText.resize(cfgLen);
+        MPI_Bcast(&cfgText[0], cfgLen, MPI_CHAR, 0, MPI_COMM_WORLD);
+        std::istringstream cfgStream(cfgText);
+        cfr.parse(cfgStream);
+#else
+        cfr.read(fname);               // Load parameters from file
+#endif
+
+        if (a > 1) Universe::reset();  // Pristine arena for the next run; backed chunks stay resident
+        runConfig(cfr);
+        // Comment: Campaigns of many short jobs pass all their configs at once
+        // (e.g. ./3dcdt.x cfg1.dat cfg2.dat ...): process startup, the pool chunk
+        // backing and the code/page warmup are paid once instead of per job. Runs
+        // are strictly sequential; the previous config's Universes are gone by the
+        // time reset() wipes the arena.
+    }
+
+#ifdef CDT_MPI
+    MPI_Finalize();
+#endif
 
     return 0;  // Exit successfully
 }
\ No newline at end of file
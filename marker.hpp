@@ -0,0 +1,46 @@
+// Copyright 2021 Joren Brunekreef, Daniel Nemeth and Andrzej Görlich
+/****
+ *
+ * Marker is an epoch-stamped visited buffer for BFS routines.
+ * It stores one integer stamp per Pool slot; an element counts as
+ * visited iff its stamp equals the current epoch. Both marking and
+ * clearing are O(1): clear() just advances the epoch, which makes
+ * every existing stamp stale at once, so no per-element reset pass
+ * (or std::find scan) is needed between searches.
+ *
+ ****/
+#pragma once  // Prevents multiple inclusions
+// Comment: Standard header guard; docstring outlines Marker’s purpose (Sec. 3.4).
+
+#include <vector>     // For the stamp array
+#include <algorithm>  // For std::fill on epoch wrap-around
+#include "pool.hpp"   // For Pool capacities and Label types
+
+// Comment: Marker tracks visited simplices during BFS with O(1) clear (Sec. 3.4).
+template <class T>  // T: Pool-derived type with Label (e.g., Vertex, Tetra)
+class Marker {
+    using Label = typename T::Label;  // Alias for T’s Label type
+    // Comment: Ensures Marker works with Pool-derived types (Sec. 3.1.1).
+
+private:
+    std::vector<unsigned> stamps;  // One stamp per Pool slot, sized to pool capacity
+    unsigned epoch;                // Current search epoch; stamps from older epochs are stale
+
+public:
+    Marker() : stamps(T::pool_capacity(), 0), epoch(1) {}
+    // Comment: Stamp 0 never equals a valid epoch, so everything starts unvisited.
+
+    void clear() {  // Invalidates all marks in O(1)
+        if (++epoch == 0) {  // Epoch wrapped; stale stamps could alias the restarted counter
+            std::fill(stamps.begin(), stamps.end(), 0);
+            epoch = 1;
+        }
+    }
+
+    void mark(Label l) { stamps[l] = epoch; }           // Marks l visited in this epoch
+    bool visited(Label l) const { return stamps[l] == epoch; }  // Checks l in this epoch
+};
+
+// HPC Targets Summary:
+// [OpenMP #3]: Parallel BFS needs one Marker per thread; instances are independent.
+// [General #10]: Contiguous stamp array is cache-friendly versus per-search vectors.
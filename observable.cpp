@@ -1,32 +1,45 @@
 // Copyright 2021 Joren Brunekreef, Daniel Nemeth and Andrzej Görlich
 #include <iostream>       // For std::cout (unused here)
 #include <fstream>        // For std::ofstream in write(), clear()
+#include <unistd.h>       // For truncate() in loadState()
 #include <vector>         // For std::vector in sphere methods
 #include "observable.hpp"  // Observable class definition
 
 // Static member initializations (Sec. 3)
-std::default_random_engine Observable::rng(0);  // RNG with default seed 0
-// TODO(JorenB): seed properly - Not seeded here; likely set elsewhere (e.g., Simulation::start)
-// HPC Target [MPI #4]: Static RNG needs per-rank instances.
 std::string Observable::data_dir = "";  // Output directory, set by main.cpp
-std::vector<bool> Observable::doneL;    // BFS visitation tracker (Sec. 3.4)
-// HPC Target [General #10]: Should be pre-allocated; [OpenMP #3]: Needs thread-local copies.
-
-void Observable::write() {  // Writes output to file (Sec. 3.4)
-    std::string filename = data_dir + "/" + name + "-" + identifier + extension;  // e.g., "data/VolumeProfile-fID.dat"
-    std::ifstream infile(filename);  // Check if file exists (unused result)
+int Observable::flush_every = 64;       // Measurements per append, set by main.cpp
+thread_local Marker<Vertex> Observable::visitedV;     // Visited vertices (sphere, sphere2d)
+thread_local Marker<Tetra> Observable::visitedT;      // Visited tetrahedra (sphereDual)
+thread_local Marker<Triangle> Observable::visitedTr;  // Visited triangles (sphere2dDual)
+// Comment: One scratch set per replica thread; the rng is a per-instance member now.
+
+std::string Observable::outputFile() const {  // e.g., "data/VolumeProfile-fID.dat"
+    return data_dir + "/" + name + "-" + identifier + extension;
+}
 
-    std::ofstream file;
-    file.open(filename, std::ios::app);  // Append mode
-    assert(file.is_open());  // Ensure file opened
+void Observable::write() {  // Buffers output; file I/O happens in flush() (Sec. 3.4)
+    pending += output;
+    pending += "\n";
+    if (++pendingCount >= flush_every) flush();
+    // Comment: Measurements accumulate in memory and reach the file in flush_every-
+    // sized appends; per-line open/append/close cost a filesystem metadata round-trip
+    // each, which dominated sweep cadence on networked filesystems.
+}
 
-    file << output << "\n";  // Write output string
-    file.close();
-    // Comment: Appends computed data from process() to file.
+void Observable::flush() const {  // Writes buffered measurements in one append
+    if (pendingCount == 0) return;
+    if (!stream.is_open()) {
+        stream.open(outputFile(), std::ios::app);  // Opened once, kept open
+        assert(stream.is_open());
+    }
+    stream << pending;   // One buffered write for the whole block
+    stream.flush();
+    pending.clear();     // Capacity is retained for the next block
+    pendingCount = 0;
 }
 
 void Observable::clear() {  // Resets observable data (Sec. 3.4)
-    std::string filename = data_dir + "/" + name + "-" + identifier + extension;
+    std::string filename = outputFile();
     std::ofstream file;
     file.open(filename, std::ios::app);  // Append mode (no truncation)
     assert(file.is_open());
@@ -37,23 +50,41 @@ void Observable::clear() {  // Resets observable data (Sec. 3.4)
     // Potential Bug: Should use std::ios::trunc to clear file if reset intended.
 }
 
+void Observable::saveState(std::ostream &file) const {  // Checkpoint hook (Sec. 3.3)
+    rng.save(file);
+    flush();  // The recorded length must cover every measurement taken so far
+
+    int64_t length = 0;  // Data written so far lives in the append-mode output file
+    std::ifstream data(outputFile(), std::ios::in | std::ios::binary | std::ios::ate);
+    if (data.is_open()) length = data.tellg();
+    file.write(reinterpret_cast<const char *>(&length), sizeof(length));
+}
+
+void Observable::loadState(std::istream &file) {  // Resume hook, inverse of saveState()
+    rng.load(file);
+
+    int64_t length;
+    file.read(reinterpret_cast<char *>(&length), sizeof(length));
+    truncate(outputFile().c_str(), length);  // Drop measurements from after the checkpoint
+    // Comment: The interrupted run may have appended lines between the last
+    // checkpoint and the crash; the resumed run reproduces them instead.
+}
+
 std::vector<Vertex::Label> Observable::sphere(Vertex::Label origin, int radius) {  // Vertex sphere (Sec. 3.4)
     std::vector<Vertex::Label> thisDepth;  // Current BFS depth
     std::vector<Vertex::Label> nextDepth;  // Next BFS depth
     std::vector<Vertex::Label> vertexList; // Resulting sphere vertices
-    std::vector<Vertex::Label> flippedVertices;  // Track visited for reset
 
-    doneL.at(origin) = true;  // Mark origin visited
+    visitedV.clear();  // O(1) epoch bump; no reset walk afterwards
+    visitedV.mark(origin);  // Mark origin visited
     thisDepth.push_back(origin);
-    flippedVertices.push_back(origin);
 
     for (int currentDepth = 0; currentDepth < radius; currentDepth++) {  // BFS loop
         for (auto v : thisDepth) {  // Process current depth
-            for (auto neighbor : Universe::vertexNeighbors[v]) {  // Check neighbors
-                if (!doneL.at(neighbor)) {  // If unvisited
-                    flippedVertices.push_back(neighbor);
+            for (auto neighbor : universe.vertexCsr[v]) {  // Check neighbors (CSR run)
+                if (!visitedV.visited(neighbor)) {  // If unvisited
                     nextDepth.push_back(neighbor);
-                    doneL.at(neighbor) = true;
+                    visitedV.mark(neighbor);
                     if (currentDepth == radius - 1) vertexList.push_back(neighbor);  // Add to result at final depth
                 }
             }
@@ -62,7 +93,6 @@ std::vector<Vertex::Label> Observable::sphere(Vertex::Label origin, int radius)
         nextDepth.clear();
     }
 
-    for (auto v : flippedVertices) doneL.at(v) = false;  // Reset visited flags
     return vertexList;
     // Comment: BFS for link distance sphere; returns vertices at radius.
     // HPC Targets [OpenMP #3, GPU #8]: Parallelizable BFS.
@@ -72,20 +102,19 @@ std::vector<Vertex::Label> Observable::sphere2d(Vertex::Label origin, int radius
     std::vector<Vertex::Label> thisDepth;
     std::vector<Vertex::Label> nextDepth;
     std::vector<Vertex::Label> vertexList;
-    std::vector<Vertex::Label> flippedVertices;
 
-    doneL.at(origin) = true;
+    visitedV.clear();  // O(1) epoch bump
+    visitedV.mark(origin);
     thisDepth.push_back(origin);
-    flippedVertices.push_back(origin);
 
+    int originTime = universe.frozenVertexTime[origin];  // Snapshot time (pipeline-safe)
     for (int currentDepth = 0; currentDepth < radius; currentDepth++) {
         for (auto v : thisDepth) {
-            for (auto neighbor : Universe::vertexNeighbors[v]) {
-                if (neighbor->time != origin->time) continue;  // Restrict to same time slice
-                if (!doneL.at(neighbor)) {
-                    flippedVertices.push_back(neighbor);
+            for (auto neighbor : universe.vertexCsr[v]) {
+                if (universe.frozenVertexTime[neighbor] != originTime) continue;  // Restrict to same time slice
+                if (!visitedV.visited(neighbor)) {
                     nextDepth.push_back(neighbor);
-                    doneL.at(neighbor) = true;
+                    visitedV.mark(neighbor);
                     if (currentDepth == radius - 1) vertexList.push_back(neighbor);
                 }
             }
@@ -94,56 +123,57 @@ std::vector<Vertex::Label> Observable::sphere2d(Vertex::Label origin, int radius
         nextDepth.clear();
     }
 
-    for (auto v : flippedVertices) doneL.at(v) = false;
     return vertexList;
     // Comment: 2D BFS within origin’s time slice; supports 2D observables (e.g., Ricci2d).
     // HPC Targets [OpenMP #3, GPU #8]: Parallelizable BFS.
 }
 
 std::vector<Tetra::Label> Observable::sphereDual(Tetra::Label origin, int radius) {  // Dual tetra sphere (Sec. 3.4)
-    // TODO(JorenB): optimize BFS (see sphere()) - Indicates potential improvement
-    std::vector<Tetra::Label> done;  // Visited tetrahedra
     std::vector<Tetra::Label> thisDepth;
     std::vector<Tetra::Label> nextDepth;
 
-    done.push_back(origin);
+    visitedT.clear();  // O(1) epoch bump; replaces the quadratic std::find scan
+    visitedT.mark(origin);
     thisDepth.push_back(origin);
     std::vector<Tetra::Label> tetraList;
 
     for (int currentDepth = 0; currentDepth < radius; currentDepth++) {
         for (auto t : thisDepth) {
-            for (auto neighbor : t->tnbr) {  // Check tetra neighbors
-                if (std::find(done.begin(), done.end(), neighbor) == done.end()) {  // If unvisited
+            for (int i = 0; i < 4; i++) {  // Check tetra neighbors (SoA mirror: 4 ints/tetra)
+                auto neighbor = Tetra::neighborOf(t, i);
+                if (!visitedT.visited(neighbor)) {  // If unvisited
                     nextDepth.push_back(neighbor);
-                    done.push_back(neighbor);
+                    visitedT.mark(neighbor);
                     if (currentDepth == radius - 1) tetraList.push_back(neighbor);
                 }
             }
         }
+        // Comment: The BFS needs only neighbor labels, so it walks the dense mirror
+        // instead of dragging each 80-byte Tetra through cache for 16 useful bytes.
         thisDepth = nextDepth;
         nextDepth.clear();
     }
 
     return tetraList;
-    // Comment: BFS for dual link distance; doesn’t use doneL (less efficient).
+    // Comment: BFS for dual link distance.
     // HPC Targets [OpenMP #3, GPU #8]: Parallelizable BFS.
 }
 
 std::vector<Triangle::Label> Observable::sphere2dDual(Triangle::Label origin, int radius) {  // 2D dual triangle sphere
-    std::vector<Triangle::Label> done;
     std::vector<Triangle::Label> thisDepth;
     std::vector<Triangle::Label> nextDepth;
 
-    done.push_back(origin);
+    visitedTr.clear();  // O(1) epoch bump; replaces the quadratic std::find scan
+    visitedTr.mark(origin);
     thisDepth.push_back(origin);
     std::vector<Triangle::Label> triangleList;
 
     for (int currentDepth = 0; currentDepth < radius; currentDepth++) {
         for (auto t : thisDepth) {
             for (auto neighbor : t->trnbr) {  // Check triangle neighbors
-                if (std::find(done.begin(), done.end(), neighbor) == done.end()) {
+                if (!visitedTr.visited(neighbor)) {
                     nextDepth.push_back(neighbor);
-                    done.push_back(neighbor);
+                    visitedTr.mark(neighbor);
                     if (currentDepth == radius - 1) triangleList.push_back(neighbor);
                 }
             }
@@ -153,6 +183,65 @@ std::vector<Triangle::Label> Observable::sphere2dDual(Triangle::Label origin, in
     }
 
     return triangleList;
-    // Comment: 2D dual BFS; doesn’t use doneL.
+    // Comment: 2D dual BFS.
+    // HPC Targets [OpenMP #3, GPU #8]: Parallelizable BFS.
+}
+
+std::vector<int> Observable::shellProfile2d(Vertex::Label origin, int maxRadius) {  // All shell sizes in one BFS
+    std::vector<int> profile;
+    std::vector<Vertex::Label> thisDepth;
+    std::vector<Vertex::Label> nextDepth;
+
+    visitedV.clear();  // O(1) epoch bump
+    visitedV.mark(origin);
+    thisDepth.push_back(origin);
+
+    int originTime = universe.frozenVertexTime[origin];  // Snapshot time (pipeline-safe)
+    while (thisDepth.size() > 0 && (maxRadius < 0 || static_cast<int>(profile.size()) <= maxRadius)) {
+        profile.push_back(thisDepth.size());  // profile[r] = vertices at distance exactly r
+        for (auto v : thisDepth) {
+            for (auto neighbor : universe.vertexCsr[v]) {
+                if (universe.frozenVertexTime[neighbor] != originTime) continue;  // Restrict to same time slice
+                if (!visitedV.visited(neighbor)) {
+                    nextDepth.push_back(neighbor);
+                    visitedV.mark(neighbor);
+                }
+            }
+        }
+        thisDepth = nextDepth;
+        nextDepth.clear();
+    }
+
+    return profile;
+    // Comment: One traversal for the whole histogram (see observable.hpp); each
+    // edge of the slice is crossed once regardless of the profile depth.
+    // HPC Targets [OpenMP #3, GPU #8]: Parallelizable BFS.
+}
+
+std::vector<int> Observable::shellProfile2dDual(Triangle::Label origin, int maxRadius) {  // Dual-graph shell sizes
+    std::vector<int> profile;
+    std::vector<Triangle::Label> thisDepth;
+    std::vector<Triangle::Label> nextDepth;
+
+    visitedTr.clear();  // O(1) epoch bump; replaces the quadratic std::find scan
+    visitedTr.mark(origin);
+    thisDepth.push_back(origin);
+
+    while (thisDepth.size() > 0 && (maxRadius < 0 || static_cast<int>(profile.size()) <= maxRadius)) {
+        profile.push_back(thisDepth.size());  // profile[r] = triangles at dual distance exactly r
+        for (auto t : thisDepth) {
+            for (auto neighbor : t->trnbr) {  // Triangle adjacency stays within the slice
+                if (!visitedTr.visited(neighbor)) {
+                    nextDepth.push_back(neighbor);
+                    visitedTr.mark(neighbor);
+                }
+            }
+        }
+        thisDepth = nextDepth;
+        nextDepth.clear();
+    }
+
+    return profile;
+    // Comment: Same single-pass engine on the dual graph.
     // HPC Targets [OpenMP #3, GPU #8]: Parallelizable BFS.
 }
\ No newline at end of file
@@ -3,10 +3,13 @@
 // Comment: Standard header guard.
 
 #include <string>        // For std::string (name, identifier, output)
+#include <fstream>       // For the persistent buffered output stream
 #include <algorithm>     // For std::fill in sphere() methods
 #include <vector>        // For std::vector in sphere and distance methods
+#include <cstdint>       // For uint64_t bitset words in batchedSphereDistance()
 #include "universe.hpp"  // Access to Universe triangulation data
 #include "simulation.hpp" // Interaction with Simulation class
+#include "marker.hpp"     // Epoch-stamped visited buffers for BFS
 
 // Comment: Observable base class for measuring geometric properties in 3D CDT (Sec. 3.4).
 class Observable {
@@ -14,10 +17,12 @@ public:
     std::string name;  // Observable name
     // Comment: Public identifier for the observable (e.g., "VolumeProfile").
 
-    Observable(std::string identifier_) {
+    Observable(std::string identifier_, Universe &universe_, Simulation &simulation_)
+        : universe(universe_), simulation(simulation_) {
         identifier = identifier_;  // Set unique identifier
     }
-    // Comment: Constructor sets identifier (e.g., file ID from main.cpp, Sec. 3).
+    // Comment: Constructor sets identifier (e.g., file ID from main.cpp, Sec. 3) and
+    // binds the observable to its replica's engine instances.
 
     void measure() {
         process();  // Compute observable
@@ -25,20 +30,66 @@ public:
     }
     // Comment: Called during simulation to measure and record (Sec. 3.3.3).
 
+    ~Observable() { flush(); }  // Pending measurements reach the file on normal exit
+
     void clear();  // Resets observable data
     // Comment: Clears prior measurements (Sec. 3.4).
 
+    void flush() const;  // Writes buffered measurements in one append
+    // Comment: Called on checkpoint, destruction and every flush_every-th write();
+    // in between, measurements accumulate in memory and the file stays open, so a
+    // sweep costs no filesystem metadata round-trip (open/close per line).
+
+    static int flush_every;  // Measurements buffered between appends
+    // Comment: Set by main.cpp from the optional "flushevery" config key; 1 restores
+    // the historical line-at-a-time behavior.
+
+    void saveState(std::ostream &file) const;  // Checkpoint hook
+    void loadState(std::istream &file);        // Resume hook
+    // Comment: The measurement stream itself lives in the append-mode output file,
+    // so besides the sampling rng only the file length is recorded; loadState()
+    // truncates back to it, dropping lines written after the checkpoint so a
+    // resumed run does not duplicate them.
+
     static std::string data_dir;  // Output directory for data files
     // Comment: Set by main.cpp; shared across all observables (Sec. 3).
 
+    bool pipelineSafe = false;  // May this observable's measure() overlap the next sweep?
+    // Comment: Set by derived constructors; checked by Simulation::measureAll()
+    // before it lets a pipelined stage run concurrently with moves. Safe means
+    // process() reads only the frozen snapshot (frozenSliceSizes, frozenVertexTime,
+    // frozenVertexScnum, frozenTriangleTime), the label snapshots (vertices,
+    // triangles) and the packed vertexCsr — all rebuilt only in updateGeometry().
+    // NOT safe: following live half-edges or dereferencing live Triangle/Tetra
+    // objects, because every add/delete/flip move retireSpatialData()s its base
+    // triangle mid-sweep, Pool-destroying the triangle and its half-edges — and
+    // Pool<HalfEdge>::destroy writes the free-list link (a negative label) into
+    // the same next field the half-edge traversals follow. Defaults to false so
+    // a new observable must be audited before it may overlap.
+
+    std::string outputFile() const;  // Data file path shared by write(), clear() and the checkpoint hooks
+    // Comment: Public so the MPI scan driver (main.cpp) can tag the blocks that
+    // successive grid points append into the aggregated per-rank data files.
+
 private:
     std::string identifier;  // Unique ID for this observable instance
     // Comment: Used for file naming (e.g., "<identifier>.dat").
 
+    mutable std::ofstream stream;    // Output file, opened once (append) on first flush
+    mutable std::string pending;     // Measurements buffered since the last flush
+    mutable int pendingCount = 0;    // Lines in pending
+    // Comment: Mutable so the const checkpoint hook saveState() can flush; the file
+    // is opened with O_APPEND semantics, so flushed blocks always land at EOF even
+    // after loadState() truncates the file underneath the open handle.
+
 protected:
-    static std::default_random_engine rng;  // RNG for observable calculations
-    // Comment: Shared RNG; usage unclear without process() implementations.
-    // HPC Target [MPI #4]: Needs per-rank instances for distributed runs.
+    Universe &universe;      // The replica's triangulation state
+    Simulation &simulation;  // The replica's simulation engine
+    // Comment: Bound at construction; one observable instance belongs to one replica.
+
+    Xoshiro256pp rng{0};  // RNG for observable calculations
+    // Comment: Per-instance engine, so replicas draw independent measurement samples.
+    // HPC Target [MPI #4]: Per-rank instances fall out of the same design.
 
     virtual void process() = 0;  // Pure virtual method to compute observable
     // Comment: Implemented by derived classes (e.g., VolumeProfile, Sec. 3.4).
@@ -48,33 +99,129 @@ protected:
     void write();  // Writes output to file
     // Comment: Saves computed data (Sec. 3.4).
 
-    static std::vector<bool> doneL;  // Tracks visited nodes in BFS
-    // Comment: Shared across instances for sphere/distance methods (Sec. 3.4).
-    // HPC Target [OpenMP #3]: Needs thread-local copies for parallel BFS.
+    static thread_local Marker<Vertex> visitedV;     // Visited vertices (sphere, sphere2d)
+    static thread_local Marker<Tetra> visitedT;      // Visited tetrahedra (sphereDual)
+    static thread_local Marker<Triangle> visitedTr;  // Visited triangles (sphere2dDual)
+    // Comment: Epoch-stamped scratch buffers, one set per replica thread; clear() is
+    // O(1), so no per-search reset walk or std::find scan is needed (Sec. 3.4).
 
     // Toolbox methods for geometric measurements (Sec. 3.4)
-    static std::vector<Vertex::Label> sphere(Vertex::Label origin, int radius);
+    std::vector<Vertex::Label> sphere(Vertex::Label origin, int radius);
     // Comment: Computes vertex sphere of radius from origin (link distance).
-    static std::vector<Vertex::Label> sphere2d(Vertex::Label origin, int radius);
+    std::vector<Vertex::Label> sphere2d(Vertex::Label origin, int radius);
     // Comment: 2D vertex sphere (within a slice).
-    static std::vector<Tetra::Label> sphereDual(Tetra::Label origin, int radius);
+    std::vector<Tetra::Label> sphereDual(Tetra::Label origin, int radius);
     // Comment: Dual tetrahedron sphere (dual link distance).
-    static std::vector<Triangle::Label> sphere2dDual(Triangle::Label origin, int radius);
+    std::vector<Triangle::Label> sphere2dDual(Triangle::Label origin, int radius);
     // Comment: 2D dual triangle sphere.
 
-    static int distance(Vertex::Label v1, Vertex::Label v2);
+    std::vector<int> shellProfile2d(Vertex::Label origin, int maxRadius);
+    // Comment: Single-pass shell-size histogram: one BFS records |sphere2d(origin, r)|
+    // for every r up to maxRadius (-1 = until the frontier empties; entry 0 is the
+    // origin itself). A radius-R profile built from per-radius sphere calls
+    // re-expands every interior shell up to R times; here each edge is crossed once.
+    std::vector<int> shellProfile2dDual(Triangle::Label origin, int maxRadius);
+    // Comment: Dual-graph counterpart on the triangle adjacency (Hausdorff profiles).
+
+    int distance(Vertex::Label v1, Vertex::Label v2);
     // Comment: Shortest link distance between vertices.
-    static int distanceDual(Tetra::Label t1, Tetra::Label t2);
+    int distanceDual(Tetra::Label t1, Tetra::Label t2);
     // Comment: Shortest dual link distance between tetrahedra.
     // HPC Target [OpenMP #3, GPU #8]: BFS methods are parallelizable.
 
+    template <class T, class Adjacency>
+    static long batchedSphereDistance(const std::vector<typename T::Label> &sources,
+                                      const std::vector<typename T::Label> &targets,
+                                      int maxDepth, int lmax, const Adjacency &adj,
+                                      const std::vector<int> &times);
+    // Comment: Sums the pairwise BFS distances from every source to every target
+    // (restricted to one slice) in a single frontier sweep. Each simplex carries a
+    // bitset of the sources that have reached it, so one level-synchronous pass
+    // replaces one full BFS per source in the Ricci observables (Sec. 3.4). The
+    // slice restriction reads the caller's frozen per-label time array (universe
+    // frozen* snapshots), keeping the sweep pipeline-safe.
+    // HPC Target [OpenMP #3]: Frontier expansion per level is parallelizable.
+
     std::string extension = ".dat";  // File extension for output
     std::string output;             // Data to write
     // Comment: Output string built by process(), saved by write().
 };
 
+template <class T, class Adjacency>
+long Observable::batchedSphereDistance(const std::vector<typename T::Label> &sources,
+                                       const std::vector<typename T::Label> &targets,
+                                       int maxDepth, int lmax, const Adjacency &adj,
+                                       const std::vector<int> &times) {
+    int nSources = sources.size();
+    int words = (nSources + 63) / 64;  // Bitset words per simplex (one bit per source)
+    std::vector<uint64_t> arrived((lmax + 1) * words, 0);  // Source bits that reached each label
+    std::vector<char> isTarget(lmax + 1, false);           // Target membership flags
+    std::vector<int> lastQueued(lmax + 1, -1);             // Depth at which a label was last enqueued
+    // Comment: Scratch state sized to the live label range (lmax from the caller).
+
+    for (auto t : targets) isTarget.at(t) = true;
+
+    std::vector<typename T::Label> thisDepth;  // Current BFS frontier
+    std::vector<typename T::Label> nextDepth;  // Next BFS frontier
+
+    long pairsLeft = static_cast<long>(nSources) * targets.size();  // Unresolved source-target pairs
+    long distanceSum = 0;
+
+    for (int i = 0; i < nSources; i++) {  // Seed every source at depth 0
+        auto s = sources[i];
+        arrived[s * words + i / 64] |= uint64_t(1) << (i % 64);
+        if (lastQueued.at(s) != 0) {
+            thisDepth.push_back(s);
+            lastQueued.at(s) = 0;
+        }
+        if (isTarget.at(s)) pairsLeft--;  // Source coincides with a target: distance 0
+    }
+
+    std::vector<uint64_t> frontierBits;  // Snapshot of frontier bit rows per level
+    for (int currentDepth = 1; currentDepth <= maxDepth; currentDepth++) {
+        frontierBits.resize(thisDepth.size() * words);
+        for (size_t f = 0; f < thisDepth.size(); f++) {  // Freeze this level's bits
+            for (int w = 0; w < words; w++)
+                frontierBits[f * words + w] = arrived[thisDepth[f] * words + w];
+        }
+        // Comment: Bits gained mid-level belong to the next depth; the snapshot keeps
+        // the sweep level-synchronous (the gainer is re-enqueued below).
+
+        for (size_t f = 0; f < thisDepth.size(); f++) {
+            auto v = thisDepth[f];
+            for (auto neighbor : adj[v]) {
+                if (times[neighbor] != times[v]) continue;  // Restrict to slice (frozen snapshot)
+                bool gained = false;
+                for (int w = 0; w < words; w++) {  // Propagate source bits not yet at neighbor
+                    uint64_t fresh = frontierBits[f * words + w] & ~arrived[neighbor * words + w];
+                    if (fresh == 0) continue;
+                    arrived[neighbor * words + w] |= fresh;
+                    gained = true;
+                    if (isTarget.at(neighbor)) {  // New sources reached a target
+                        int found = __builtin_popcountll(fresh);
+                        distanceSum += static_cast<long>(currentDepth) * found;
+                        pairsLeft -= found;
+                    }
+                }
+                if (gained && lastQueued.at(neighbor) != currentDepth) {
+                    nextDepth.push_back(neighbor);
+                    lastQueued.at(neighbor) = currentDepth;
+                }
+            }
+            if (pairsLeft == 0) break;
+        }
+        thisDepth = nextDepth;
+        nextDepth.clear();
+        if (pairsLeft == 0) break;  // Early exit
+    }
+    assert(pairsLeft == 0);  // Ensure every source reached every target
+
+    return distanceSum;
+    // HPC Target [General #10]: Word-packed frontiers keep the sweep cache-friendly.
+}
+
 // HPC Targets Summary:
 // [OpenMP #3]: Parallelize BFS in sphere/distance methods (Sec. 3.4).
 // [GPU #8]: GPU-accelerate BFS for large radii (Sec. 3.4).
 // [MPI #4]: Distribute rng for parallel runs (Sec. 2).
-// [General #10]: Pre-allocate doneL and output buffers (Sec. 3.1).
\ No newline at end of file
+// [General #10]: Pre-allocate output buffers (Sec. 3.1).
\ No newline at end of file
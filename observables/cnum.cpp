@@ -3,28 +3,27 @@
 
 // Comment: Implements CNum to measure the spatial coordination number (scnum) distribution (Sec. 3.4).
 void CNum::process() {
-    std::string tmp = "";  // Output string
-
     std::array<int, 750> histogram;  // Histogram of scnum values
     std::fill(histogram.begin(), histogram.end(), 0);  // Initialize to zero
     // Comment: Fixed-size array for scnum counts, assuming max scnum < 750 (Sec. 3.2.2).
 
-    for (auto v : Universe::vertices) {  // Iterate over vertices
-        if (Universe::sliceSizes[v->time] != Simulation::target2Volume) continue;  // Filter by slice
-        if (v->scnum > histogram.size() - 1) {  // Check for overflow
-            printf("overflow. cnum: %d\n", v->scnum);  // Log overflow
+    for (auto v : universe.vertices) {  // Iterate over vertices
+        int scnum = universe.frozenVertexScnum[v];  // Snapshot fields (pipeline-safe)
+        if (universe.frozenSliceSizes[universe.frozenVertexTime[v]] != simulation.target2Volume) continue;  // Filter by slice
+        if (scnum > static_cast<int>(histogram.size()) - 1) {  // Check for overflow
+            printf("overflow. cnum: %d\n", scnum);  // Log overflow
             continue;  // Skip if scnum exceeds histogram size
         }
-        histogram.at(v->scnum) += 1;  // Increment bin for spatial coordination number
+        histogram.at(scnum) += 1;  // Increment bin for spatial coordination number
     }
     // Comment: Builds histogram of scnum for vertices in target slice (Sec. 3.4).
 
+    output.clear();  // Reused across measurements; capacity is retained
     for (auto h : histogram) {  // Format output
-        tmp += std::to_string(h) + " ";
+        output += std::to_string(h);
+        output += " ";
     }
-    tmp.pop_back();  // Remove trailing space
-
-    output = tmp;  // Set for Observable::write()
+    output.pop_back();  // Remove trailing space
     // Comment: Outputs space-separated histogram (e.g., "0 5 10 ...") (Sec. 3.4).
-    // HPC Targets [OpenMP #2, General #10]: Parallelize loop; optimize tmp allocation.
+    // HPC Target [OpenMP #2]: Parallelize loop.
 }
\ No newline at end of file
@@ -9,8 +9,9 @@
 // Comment: CNum measures the coordination number (cnum) distribution in 3D CDT (Sec. 3.4).
 class CNum : public Observable {  // Inherits from Observable
 public:
-    CNum(std::string id) : Observable(id) {  // Constructor
+    CNum(std::string id, Universe &u, Simulation &s) : Observable(id, u, s) {  // Constructor
         name = "cnum";  // Set observable name
+        pipelineSafe = true;  // Reads only the frozen snapshot fields (observable.hpp)
     }
     // Comment: Initializes with identifier (e.g., from main.cpp); sets name for output file (Sec. 3).
 
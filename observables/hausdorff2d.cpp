@@ -3,38 +3,37 @@
 
 // Comment: Implements Hausdorff2d to measure 2D Hausdorff dimension on spatial slices (Sec. 3.4).
 void Hausdorff2d::process() {
-    std::string tmp = "";  // Output string
     std::vector<int> profile = {};  // Profile of sphere sizes or distances
     int max_epsilon = 30;  // Maximum distance/epsilon for measurement
     profile.resize(max_epsilon, 0);  // Pre-allocate profile up to max_epsilon
     // Comment: max_epsilon shadows class member; likely meant to be configurable.
 
     int vmax = 0;  // Maximum vertex label
-    for (auto v : Universe::vertices) {
+    for (auto v : universe.vertices) {
         if (v > vmax) vmax = v;  // Find max vertex index
     }
-    doneL.resize(vmax + 1, false);  // Resize BFS visitation flags (inherited from Observable)
-    // Comment: Prepares doneL for BFS; size based on vertex count (Sec. 3.4).
 
     if (!average) {  // Non-averaged mode
-        for (int i = 1; i <= max_epsilon; i++) {
-            Vertex::Label v;
-            do {  // Select vertex from slice matching target2Volume
-                v = Universe::verticesAll.pick();  // Random vertex (Sec. 3.1.2)
-            } while (Universe::sliceSizes[v->time] != Simulation::target2Volume);
-
-            auto s1 = sphere2d(v, i);  // 2D sphere at radius i (Sec. 3.4)
-            profile.at(i - 1) = s1.size();  // Store sphere size
-        }
+        Vertex::Label v;
+        do {  // Select vertex from slice matching target2Volume
+            v = universe.vertices[rng.bounded(universe.vertices.size())];  // Random vertex, snapshot list (Sec. 3.2)
+        } while (universe.frozenSliceSizes[universe.frozenVertexTime[v]] != simulation.target2Volume);
+
+        auto shells = shellProfile2d(v, max_epsilon);  // All radii in one BFS (observable.hpp)
+        for (int i = 1; i <= max_epsilon && i < static_cast<int>(shells.size()); i++)
+            profile.at(i - 1) = shells.at(i);  // Shell sizes from the single traversal
+        // Comment: One origin and one frontier expansion per measurement; the old
+        // loop drew a fresh origin and re-ran sphere2d() for each radius, paying
+        // O(R^2) redundant traversal for a radius-R profile.
     } else if (average) {  // Averaged mode
         printf("avg\n");
 
         int counter = 0;  // Number of vertices processed
-        for (auto v : Universe::verticesAll) {  // Iterate over all vertices
-            if (Universe::sliceSizes[v->time] != Simulation::target2Volume) continue;  // Filter by slice
+        for (auto v : universe.verticesAll) {  // Iterate over all vertices
+            if (universe.sliceSizes[v->time] != simulation.target2Volume) continue;  // Filter by slice
             counter++;
 
-            auto singleProfile = distanceList2d(v);  // Compute distance profile for v
+            auto singleProfile = shellProfile2d(v, -1);  // Full profile, one BFS (observable.hpp)
             if (singleProfile.size() > profile.size()) profile.resize(singleProfile.size(), 0);  // Expand if needed
 
             std::string tmp = "";  // Local tmp (shadows outer tmp; unused in final output)
@@ -50,42 +49,12 @@ void Hausdorff2d::process() {
     }
     // HPC Target [OpenMP #2]: Parallelize vertex loop in average mode.
 
+    output.clear();  // Reused across measurements; capacity is retained
     for (auto d : profile) {  // Format output
-        tmp += std::to_string(d) + " ";
+        output += std::to_string(d);
+        output += " ";
     }
-    tmp.pop_back();  // Remove trailing space
-    output = tmp;    // Set for Observable::write()
-    // HPC Target [General #10]: Pre-allocate tmp for cache efficiency.
-}
-
-std::vector<int> Hausdorff2d::distanceList2d(Vertex::Label origin) {
-    // TODO(JorenB): optimize BFS - Indicates potential improvement
-    std::vector<int> dsts;  // Distance profile (sphere sizes per depth)
-    std::vector<Vertex::Label> done;  // Visited vertices
-    std::vector<Vertex::Label> thisDepth;  // Current BFS depth
-    std::vector<Vertex::Label> nextDepth;  // Next BFS depth
-
-    done.push_back(origin);
-    thisDepth.push_back(origin);
-
-    int currentDepth = 0;  // Unused; could track depth explicitly
-    do {
-        for (auto v : thisDepth) {
-            for (auto neighbor : Universe::vertexNeighbors[v]) {
-                if (neighbor->time != origin->time) continue;  // Restrict to slice
-                if (std::find(done.begin(), done.end(), neighbor) == done.end()) {  // Unvisited
-                    nextDepth.push_back(neighbor);
-                    done.push_back(neighbor);
-                }
-            }
-        }
-        dsts.push_back(thisDepth.size());  // Record sphere size at this depth
-
-        thisDepth = nextDepth;
-        nextDepth.clear();
-        currentDepth++;  // Increment depth (unused in output)
-    } while (thisDepth.size() > 0);
-
-    return dsts;  // Comment: Returns sphere sizes up to max distance (Sec. 3.4).
-    // HPC Targets [OpenMP #3, GPU #8]: Parallelize BFS for speedup.
+    output.pop_back();  // Remove trailing space
+    // Comment: The former local distanceList2d() helper (Marker-less BFS with a
+    // std::find visited scan) is subsumed by the shared single-pass profile engine.
 }
\ No newline at end of file
@@ -24,15 +24,17 @@ public:
     // Comment: Inherits the constructor(s) of the base Observable class (C++11 feature), allowing Hausdorff2d to use Observable(id) directly without redefining it.
     // This ensures the base class's initialization (e.g., setting identifier) is reused.
 
-    Hausdorff2d(std::string id) : Observable(id) {  // Default constructor
+    Hausdorff2d(std::string id, Universe &u, Simulation &s) : Observable(id, u, s) {  // Default constructor
         name = "hausdorff2d";  // Sets the observable's name, used for output file naming (e.g., "data/hausdorff2d-<id>.dat").
         average = false;       // Default behavior: no averaging of distances; likely outputs raw sphere sizes or distances.
+        pipelineSafe = true;   // Non-averaged mode reads only vertexCsr + frozen fields (observable.hpp)
     }
     // Comment: Constructs an instance with a given identifier (e.g., from main.cpp) and defaults to non-averaged mode.
 
-    Hausdorff2d(std::string id, bool average_) : Observable(id) {  // Parameterized constructor
+    Hausdorff2d(std::string id, Universe &u, Simulation &s, bool average_) : Observable(id, u, s) {  // Parameterized constructor
         name = "hausdorff2d";  // Consistent naming for output identification.
         average = average_;    // Allows customization of whether to average distances or report raw values.
+        pipelineSafe = !average_;  // Averaged mode iterates the live verticesAll Bag and live sliceSizes (observable.hpp)
     }
     // Comment: Alternative constructor providing flexibility to toggle averaging behavior, initialized with an id and average flag from the caller (e.g., main.cpp).
 
@@ -54,16 +56,14 @@ private:
     // Comment: Overrides Observable::initialize() with an empty implementation, indicating no persistent state setup is needed beyond the base class.
     // Suggests that Hausdorff2d computes its measurements on-the-fly using Universe data (Sec. 3.4).
 
-    std::vector<int> distanceList2d(Vertex::Label origin);
-    // Comment: Declares a helper method to compute a list of 2D distances from a given vertex (origin) within its spatial slice.
-    // Likely uses Observable::sphere2d() or Observable::distance() to gather distances or sphere sizes (Sec. 3.4).
-    // Returns a vector of integers, possibly representing sphere sizes at increasing radii or pairwise distances.
-    // HPC Target [GPU #8]: If BFS-based (e.g., via sphere2d), this could be GPU-accelerated for significant speedup (10-50x).
+    // Comment: The distance profile comes from Observable::shellProfile2d(), the
+    // shared single-pass BFS engine; both modes read their shell sizes from one
+    // traversal per origin (Sec. 3.4).
 };
 
 // HPC Targets Summary:
 // [OpenMP #2]: Parallelize process() if it loops over vertices or slices to compute measurements (Sec. 3.4).
 //             Potential speedup: 4-16x by distributing work across threads, depending on vertex count or slice size.
-// [OpenMP #3]: Parallelize BFS in distanceList2d() if it uses breadth-first search (e.g., sphere2d), offering 2-4x speedup per call (Sec. 3.4).
-// [GPU #8]: GPU-accelerate BFS operations in distanceList2d() for large max_epsilon, potentially achieving 10-50x speedup (Sec. 3.4).
-// [General #10]: Pre-allocate vectors (e.g., in process() or distanceList2d()) to avoid dynamic resizing, improving cache efficiency (20-50% potential, Sec. 3.1).
\ No newline at end of file
+// [OpenMP #3]: Parallelize BFS in Observable::shellProfile2d(), offering 2-4x speedup per call (Sec. 3.4).
+// [GPU #8]: GPU-accelerate BFS operations in shellProfile2d() for large max_epsilon, potentially achieving 10-50x speedup (Sec. 3.4).
+// [General #10]: Pre-allocate vectors (e.g., in process()) to avoid dynamic resizing, improving cache efficiency (20-50% potential, Sec. 3.1).
\ No newline at end of file
@@ -13,8 +13,10 @@ public:
     using Observable::Observable;  // Inherits Observable constructors
     // Comment: Allows base class constructor to be used directly (e.g., Observable(id)).
 
-    Hausdorff2dDual(std::string id) : Observable(id) {  // Constructor
+    Hausdorff2dDual(std::string id, Universe &u, Simulation &s) : Observable(id, u, s) {  // Constructor
         name = "hausdorff2d_dual";  // Set observable name
+        // pipelineSafe stays false: shellProfile2dDual() walks live Triangle
+        // objects, which moves retireSpatialData() mid-sweep (observable.hpp).
     }
     // Comment: Initializes with identifier (e.g., from main.cpp); no averaging option (Sec. 3).
 
@@ -28,14 +30,12 @@ private:
 
     void initialize() {}  // Empty initialization
     // Comment: Overrides Observable::initialize(); no setup needed (Sec. 3.4).
-
-    std::vector<int> distanceList2dDual(Triangle::Label origin);  // Computes dual 2D distances
-    // Comment: Helper method; likely uses Observable::sphere2dDual (Sec. 3.4).
-    // HPC Target [GPU #8]: GPU-acceleratable if BFS-based.
+    // Comment: The distance profile comes from Observable::shellProfile2dDual(),
+    // the shared single-pass BFS engine (Sec. 3.4).
 };
 
 // HPC Targets Summary:
 // [OpenMP #2]: Parallelize process() if it loops over triangles or slices (Sec. 3.4).
-// [OpenMP #3]: Parallelize BFS in distanceList2dDual() if applicable (Sec. 3.4).
+// [OpenMP #3]: Parallelize BFS in Observable::shellProfile2dDual() if applicable (Sec. 3.4).
 // [GPU #8]: GPU-accelerate BFS for large max_epsilon (Sec. 3.4).
-// [General #10]: Pre-allocate vectors in process() or distanceList2dDual() (Sec. 3.1).
\ No newline at end of file
+// [General #10]: Pre-allocate vectors in process() or shellProfile2dDual() (Sec. 3.1).
\ No newline at end of file
@@ -5,11 +5,9 @@
 
 // Comment: Implements Minbu to measure minimal bunching (Minbu) observable (Sec. 3.4).
 void Minbu::process() {
-    std::string tmp = "";  // Output string
-
     int slice;  // Target time slice
-    for (int i = 0; i < Universe::nSlices; i++) {
-        if (Universe::sliceSizes[i] == Simulation::target2Volume) {  // Find slice matching target2Volume
+    for (int i = 0; i < universe.nSlices; i++) {
+        if (universe.frozenSliceSizes[i] == simulation.target2Volume) {  // Find slice matching target2Volume
             slice = i;
             break;
         }
@@ -17,8 +15,8 @@ void Minbu::process() {
     // Comment: Selects a slice with vertex count matching target2Volume (Sec. 2.4).
 
     std::unordered_map<int, HalfEdge::Label> sliceEdges;  // Half-edges in target slice
-    for (auto he : Universe::halfEdges) {
-        if (he->vs[0]->time == slice) sliceEdges[he] = he;  // Collect edges where start vertex is in slice
+    for (auto he : universe.halfEdges) {
+        if (universe.frozenVertexTime[he->vs[0]] == slice) sliceEdges[he] = he;  // Collect edges where start vertex is in slice
     }
     // Comment: Maps half-edge indices to labels for slice-specific edges (Sec. 3.2).
 
@@ -51,13 +49,17 @@ void Minbu::process() {
                     std::array<Vertex::Label, 3> nek = {f->vs[0], b->vs[1], f->vs[1]};  // Triangle vertices
                     std::sort(nek.begin(), nek.end());  // Sort for uniqueness
                     minNecks.push_back(nek);  // Add minimal neck
-                    for (auto t : Universe::tetras31) {  // Verify no tetra contains this triangle
-                        if (t->hasVertex(nek[0]) && t->hasVertex(nek[1]) && t->hasVertex(nek[2])) {
+                    for (auto tri : universe.vertexTriangles[nek[0]]) {  // Verify no tetra contains this triangle
+                        if (tri->hasVertex(nek[1]) && tri->hasVertex(nek[2])) {
+                            Tetra::Label t = tri->hes[0]->tetra;  // The (3,1)-tetra whose base this is
                             t->log();
                             std::cout << std::flush;
                             assert(false);  // Should not happen in minimal neck
                         }
                     }
+                    // Comment: A (3,1)-tetra contains all three slice vertices exactly when its
+                    // base triangle is the neck, so checking nek[0]'s incident triangles
+                    // (O(degree), via Universe::vertexTriangles) replaces the tetras31 scan.
                 }
             }
         }
@@ -78,15 +80,11 @@ void Minbu::process() {
     printf("------\n");
 
     std::vector<int> histogram;  // Histogram of region sizes
-    histogram.resize(Simulation::target2Volume / 2 + 1, 0);  // Size bins up to half target2Volume
+    histogram.resize(simulation.target2Volume / 2 + 1, 0);  // Size bins up to half target2Volume
     for (auto neck : minNecks) {
-        Triangle::Label tr;  // Find a triangle containing neck vertex
-        for (auto tri : Universe::triangles) {
-            if (tri->hasVertex(neck[0]) || tri->hasVertex(neck[1]) || tri->hasVertex(neck[2])) {
-                tr = tri;
-                break;
-            }
-        }
+        Triangle::Label tr = universe.vertexTriangles[neck[0]].front();  // Any triangle on the neck
+        // Comment: O(1) BFS seed from the incidence index instead of scanning all
+        // triangles; either side of the neck works, the histogram folds complements.
 
         auto origin = tr;  // Start BFS from this triangle
         std::vector<Triangle::Label> tdone;  // Visited triangles
@@ -120,17 +118,19 @@ void Minbu::process() {
             currentDepth++;
         } while (thisDepth.size() > 0);
 
-        if (totalTr + 1 < Simulation::target2Volume / 2) {  // Bin region size
+        if (totalTr + 1 < simulation.target2Volume / 2) {  // Bin region size
             histogram.at(totalTr + 1) += 1;  // Smaller region
         } else {
-            histogram.at(Simulation::target2Volume - totalTr - 1) += 1;  // Larger region’s complement
+            histogram.at(simulation.target2Volume - totalTr - 1) += 1;  // Larger region’s complement
         }
     }
     // Comment: BFS counts triangles in regions separated by minimal necks; builds histogram (Sec. 3.4).
 
+    output.clear();  // Reused across measurements; capacity is retained
     for (auto h : histogram) {  // Format output
-        tmp += std::to_string(h) + " ";
+        output += std::to_string(h);
+        output += " ";
     }
-    output = tmp;  // Set for Observable::write(); trailing space not removed
+    // Comment: Trailing space kept, as in the historical format.
     // HPC Targets [OpenMP #2, GPU #8]: Parallelize neck loop; optimize BFS and histogram.
 }
\ No newline at end of file
@@ -13,8 +13,11 @@ public:
     using Observable::Observable;  // Inherits Observable constructors
     // Comment: Allows base class constructor to be used directly (e.g., Observable(id)).
 
-    Minbu(std::string id) : Observable(id) {  // Constructor
+    Minbu(std::string id, Universe &u, Simulation &s) : Observable(id, u, s) {  // Constructor
         name = "minbu";  // Set observable name
+        // pipelineSafe stays false: process() follows live he->next/adj/prev
+        // chains, and Pool<HalfEdge>::destroy writes the free-list link into
+        // next when moves retire spatial data mid-sweep (observable.hpp).
     }
     // Comment: Initializes with identifier (e.g., from main.cpp); sets name for output file (Sec. 3).
 
@@ -17,22 +17,21 @@ void Ricci2d::process() {
     std::vector<double> epsilonDistanceList;  // Stores average distances per epsilon
     std::vector<Vertex::Label> origins;       // Origin vertices for each epsilon
 
-    int vmax = 0;  // Maximum vertex label
-    for (auto v : Universe::vertices) {
+    vmax = 0;  // Maximum vertex label
+    for (auto v : universe.vertices) {
         if (v > vmax) vmax = v;  // Find max vertex index
     }
-    doneL.resize(vmax + 1, false);    // Resize BFS visitation flags
-    doneLr.resize(vmax + 1, false);   // Resize local BFS flags
-    vertexLr.resize(vmax + 1, false); // Resize vertex flags
-    // Comment: Prepares vectors for BFS; doneL inherited from Observable (Sec. 3.4).
+    // Comment: Bounds the label range for the batched BFS kernel (Sec. 3.4).
 
     for (std::vector<int>::iterator it = epsilons.begin(); it != epsilons.end(); it++) {
         Vertex::Label v;
         do {  // Select vertex from slice matching target2Volume
-            v = Universe::verticesAll.pick();  // Random vertex (Sec. 3.1.2)
-        } while (Universe::sliceSizes[v->time] != Simulation::target2Volume);
+            v = universe.vertices[rng.bounded(universe.vertices.size())];  // Random vertex, snapshot list (Sec. 3.2)
+        } while (universe.frozenSliceSizes[universe.frozenVertexTime[v]] != simulation.target2Volume);
         origins.push_back(v);  // Store origin for this epsilon
     }
+    // Comment: Sampling and the slice filter read the frozen snapshot, so the whole
+    // measurement is pipeline-safe (and on the per-observable rng stream).
     // HPC Target [OpenMP #2]: Could parallelize origin selection with thread-local RNG.
 
     for (int i = 0; i < epsilons.size(); i++) {  // Process each epsilon
@@ -43,78 +42,36 @@ void Ricci2d::process() {
     }
     // HPC Target [OpenMP #2]: Parallelize this loop with private epsilonDistanceList.
 
-    std::string tmp = "";
+    output.clear();  // Reused across measurements; capacity is retained
     for (double dst : epsilonDistanceList) {  // Format output
-        tmp += std::to_string(dst) + " ";
+        output += std::to_string(dst);
+        output += " ";
     }
-    tmp.pop_back();  // Remove trailing space
-    output = tmp;    // Set for Observable::write()
-    // HPC Target [General #10]: Pre-allocate tmp for cache efficiency.
+    output.pop_back();  // Remove trailing space
 }
 
 double Ricci2d::averageSphereDistance(Vertex::Label p1, int epsilon) {
     auto s1 = sphere2d(p1, epsilon);  // 2D sphere around p1 (Sec. 3.4)
     if (s1.size() == 0) return 0.0;   // Early exit if empty
-    int t1 = p1->time;                // Time slice of p1
+    int t1 = universe.frozenVertexTime[p1];  // Time slice of p1
 
-    std::uniform_int_distribution<> rv(0, s1.size() - 1);
-    auto p2 = s1.at(rv(rng));         // Random vertex from s1
+    auto p2 = s1.at(rng.bounded(s1.size()));  // Random vertex from s1
     auto s2 = sphere2d(p2, epsilon);  // 2D sphere around p2
     if (s2.size() == 0) return 0.0;   // Early exit if empty
-    int t2 = p2->time;                // Time slice of p2 (should match t1)
+    int t2 = universe.frozenVertexTime[p2];  // Time slice of p2 (should match t1)
 
     if (s2.size() < s1.size()) {  // Ensure s1 is smaller for efficiency
         std::swap(s1, s2);
     }
 
-    std::vector<int> distanceList;  // Distances from s1 vertices to s2
+    long distanceSum = batchedSphereDistance<Vertex>(s1, s2, 3 * epsilon + 1, vmax,
+                                                     universe.vertexCsr,
+                                                     universe.frozenVertexTime);
+    // Comment: One multi-source frontier sweep resolves all s1-to-s2 distances,
+    // replacing the per-source BFS (and its two std::fill passes) over the slice.
 
-    for (auto b : s1) {  // BFS from each vertex in s1
-        std::fill(doneLr.begin(), doneLr.end(), false);    // Reset BFS flags
-        std::fill(vertexLr.begin(), vertexLr.end(), false); // Reset vertex flags
-        for (auto v : s2) {
-            vertexLr.at(v) = true;  // Mark s2 vertices as targets
-        }
-
-        int countdown = s2.size();  // Number of targets to find
-        std::vector<Vertex::Label> thisDepth;  // Current BFS depth
-        std::vector<Vertex::Label> nextDepth;  // Next BFS depth
-
-        doneLr.at(b) = true;
-        thisDepth.push_back(b);
-
-        for (int currentDepth = 0; currentDepth < 3 * epsilon + 1; currentDepth++) {
-            for (auto v : thisDepth) {
-                if (vertexLr.at(v)) {  // Found a target
-                    distanceList.push_back(0);  // Distance 0 (same vertex)
-                    vertexLr.at(v) = false;
-                    countdown--;
-                }
-
-                for (auto neighbor : Universe::vertexNeighbors[v]) {
-                    if (neighbor->time != v->time) continue;  // Restrict to slice
-                    if (!doneLr.at(neighbor)) {
-                        nextDepth.push_back(neighbor);
-                        doneLr.at(neighbor) = true;
-                        if (vertexLr.at(neighbor)) {  // Found a target
-                            distanceList.push_back(currentDepth + 1);
-                            vertexLr.at(neighbor) = false;
-                            countdown--;
-                        }
-                    }
-                    if (countdown == 0) break;  // All targets found
-                }
-                if (countdown == 0) break;
-            }
-            thisDepth = nextDepth;
-            nextDepth.clear();
-            if (countdown == 0) break;  // Early exit
-        }
-        assert(countdown == 0);  // Ensure all s2 vertices found
-    }
-
-    int distanceSum = std::accumulate(distanceList.begin(), distanceList.end(), 0);
-    double averageDistance = static_cast<double>(distanceSum) / (epsilon * distanceList.size());
+    long nPairs = static_cast<long>(s1.size()) * s2.size();  // All pairs resolved
+    double averageDistance = static_cast<double>(distanceSum) / (epsilon * nPairs);
     return averageDistance;
-    // HPC Targets [OpenMP #3, GPU #8]: Parallelize BFS; optimize vector usage.
+    // HPC Targets [OpenMP #3, GPU #8]: Parallelize frontier expansion; optimize vector usage.
 }
\ No newline at end of file
@@ -3,21 +3,23 @@
 // Comment: Standard header guard; note earlier copyright year (2020) vs. others (2021).
 
 #include <string>           // For std::string (id, name)
-#include <vector>           // For std::vector (epsilons, doneLr, vertexLr)
+#include <vector>           // For std::vector (epsilons)
 #include "../observable.hpp" // Base Observable class
 #include "../universe.hpp"   // Access to Universe triangulation data
 
 // Comment: Ricci2d measures 2D Ricci curvature on spatial slices in 3D CDT (Sec. 3.4).
 class Ricci2d : public Observable {  // Inherits from Observable
 public:
-    Ricci2d(std::string id) : Observable(id) {  // Default constructor
+    Ricci2d(std::string id, Universe &u, Simulation &s) : Observable(id, u, s) {  // Default constructor
         name = "ricci2d";  // Set observable name
         eps_max = 10;      // Default maximum epsilon (radius)
+        pipelineSafe = true;  // BFS runs on vertexCsr + frozen fields (observable.hpp)
     }
 
-    Ricci2d(std::string id, int eps_max_) : Observable(id) {  // Parameterized constructor
+    Ricci2d(std::string id, Universe &u, Simulation &s, int eps_max_) : Observable(id, u, s) {  // Parameterized constructor
         name = "ricci2d";  // Set observable name
         eps_max = eps_max_; // Set custom maximum epsilon
+        pipelineSafe = true;  // BFS runs on vertexCsr + frozen fields (observable.hpp)
     }
     // Comment: Constructors initialize with identifier (e.g., from main.cpp) and set epsilon range (Sec. 3).
 
@@ -32,13 +34,9 @@ private:
     std::vector<int> epsilons;  // List of epsilon values computed
     // Comment: Stores computed sphere distances or radii used (Sec. 3.4).
 
-    std::vector<bool> doneLr;  // Visitation flags for BFS (likely per vertex or tetra)
-    // Comment: Tracks visited nodes; specific use unclear without process().
-    // HPC Target [OpenMP #3]: Needs thread-local copies for parallel BFS.
-
-    std::vector<bool> vertexLr;  // Vertex-specific flags
-    // Comment: Likely tracks processed vertices; purpose depends on process().
-    // HPC Target [OpenMP #2]: Thread safety needed if updated in parallel.
+    int vmax;  // Maximum live vertex label, set in process()
+    // Comment: Bounds the scratch arrays of batchedSphereDistance() (Sec. 3.4).
+    // HPC Target [OpenMP #3]: Kernel scratch state must be thread-local for parallel BFS.
 
     double averageSphereDistance(Vertex::Label p1, int epsilon);  // Computes average distance
     // Comment: Helper method for curvature; likely uses Observable::sphere2d (Sec. 3.4).
@@ -52,4 +50,4 @@ private:
 // [OpenMP #2]: Parallelize process() for vertex loops (Sec. 3.4).
 // [OpenMP #3]: Parallelize BFS in averageSphereDistance() (Sec. 3.4).
 // [GPU #8]: GPU-accelerate BFS for large epsilon (Sec. 3.4).
-// [General #10]: Pre-allocate epsilons, doneLr, vertexLr (Sec. 3.1).
\ No newline at end of file
+// [General #10]: Pre-allocate epsilons and kernel scratch arrays (Sec. 3.1).
\ No newline at end of file
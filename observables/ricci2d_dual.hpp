@@ -3,19 +3,21 @@
 // Comment: Standard header guard; earlier copyright (2020) vs. others (2021).
 
 #include <string>           // For std::string (id, name)
-#include <vector>           // For std::vector (epsilons, doneLr, triangleLr)
+#include <vector>           // For std::vector (epsilons)
 #include "../observable.hpp" // Base Observable class
 #include "../universe.hpp"   // Access to Universe triangulation data
 
 // Comment: Ricci2dDual measures 2D Ricci curvature in the dual graph of spatial slices (Sec. 3.4).
 class Ricci2dDual : public Observable {  // Inherits from Observable
 public:
-    Ricci2dDual(std::string id) : Observable(id) {  // Default constructor
+    Ricci2dDual(std::string id, Universe &u, Simulation &s) : Observable(id, u, s) {  // Default constructor
         name = "ricci2d_dual";  // Set observable name
         eps_max = 10;           // Default maximum epsilon (radius)
+        // pipelineSafe stays false: sphere2dDual() walks live Triangle objects,
+        // which moves retireSpatialData() mid-sweep (observable.hpp).
     }
 
-    Ricci2dDual(std::string id, int eps_max_) : Observable(id) {  // Parameterized constructor
+    Ricci2dDual(std::string id, Universe &u, Simulation &s, int eps_max_) : Observable(id, u, s) {  // Parameterized constructor
         name = "ricci2d_dual";  // Set observable name
         eps_max = eps_max_;     // Set custom maximum epsilon
     }
@@ -32,13 +34,9 @@ private:
     std::vector<int> epsilons;  // List of epsilon values computed
     // Comment: Stores radii or distances for dual curvature (Sec. 3.4).
 
-    std::vector<bool> doneLr;  // Visitation flags for dual BFS
-    // Comment: Tracks visited triangles or tetrahedra in BFS (Sec. 3.4).
-    // HPC Target [OpenMP #3]: Needs thread-local copies for parallel BFS.
-
-    std::vector<bool> triangleLr;  // Triangle-specific flags
-    // Comment: Likely tracks processed triangles in dual graph (Sec. 3.4).
-    // HPC Target [OpenMP #2]: Thread safety needed if updated in parallel.
+    int tmax;  // Maximum live triangle label, set in process()
+    // Comment: Bounds the scratch arrays of batchedSphereDistance() (Sec. 3.4).
+    // HPC Target [OpenMP #3]: Kernel scratch state must be thread-local for parallel BFS.
 
     double averageSphereDistanceDual(Triangle::Label p1, int epsilon);  // Computes dual average distance
     // Comment: Helper method for dual curvature; uses Observable::sphere2dDual (Sec. 3.4).
@@ -52,4 +50,4 @@ private:
 // [OpenMP #2]: Parallelize process() for triangle loops (Sec. 3.4).
 // [OpenMP #3]: Parallelize BFS in averageSphereDistanceDual() (Sec. 3.4).
 // [GPU #8]: GPU-accelerate BFS for large epsilon (Sec. 3.4).
-// [General #10]: Pre-allocate epsilons, doneLr, triangleLr (Sec. 3.1).
\ No newline at end of file
+// [General #10]: Pre-allocate epsilons and kernel scratch arrays (Sec. 3.1).
\ No newline at end of file
@@ -3,15 +3,14 @@
 
 // Comment: Implements the process() method to compute the volume profile across time slices (Sec. 3.4).
 void VolumeProfile::process() {
-    std::string tmp = "";  // Temporary string to build output
-    for (auto l : Universe::sliceSizes) {  // Iterate over time slices
-        tmp += std::to_string(l);  // Append volume (vertices per slice)
-        tmp += " ";                // Space separator
+    output.clear();  // Reused across measurements; capacity is retained
+    for (auto l : universe.frozenSliceSizes) {  // Iterate over time slices (snapshot)
+        output += std::to_string(l);  // Append volume (vertices per slice)
+        output += " ";                // Space separator
     }
-    tmp.pop_back();  // Remove trailing space
-
-    output = tmp;  // Set output string for Observable::write()
+    output.pop_back();  // Remove trailing space
     // Comment: Generates a space-separated list of slice volumes (Sec. 3.4).
+    // Appending into the persistent output member avoids a fresh allocation per
+    // measurement; Observable::write() buffers it for the next batched flush.
     // HPC Target [OpenMP #2]: Parallelizable loop with thread-local string buffers.
-    // HPC Target [General #10]: Pre-allocating tmp could improve cache efficiency.
 }
\ No newline at end of file
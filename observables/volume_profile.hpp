@@ -9,8 +9,9 @@
 // Comment: VolumeProfile measures the volume distribution across time slices in 3D CDT (Sec. 3.4).
 class VolumeProfile : public Observable {  // Inherits from Observable
 public:
-    VolumeProfile(std::string id) : Observable(id) {  // Constructor
+    VolumeProfile(std::string id, Universe &u, Simulation &s) : Observable(id, u, s) {  // Constructor
         name = "volume_profile";  // Set observable name
+        pipelineSafe = true;      // Reads only frozenSliceSizes (observable.hpp)
     }
     // Comment: Initializes with identifier (e.g., from main.cpp); sets name for output file (Sec. 3).
 
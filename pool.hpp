@@ -12,30 +12,61 @@ There exists only a single copy of a pool for given type.
 #include <cstdio>      // For printf in check_in_pool(), log()
 #include <array>       // For std::array in Pool and derived classes
 #include <cassert>     // For assert() in memory management
+#include <mutex>       // For std::mutex guarding the shared free list
+#include <vector>      // For the deferred-reclamation slot list
 #include <random>      // Unused here; likely included for derived classes
 #include <string>      // Unused here; possibly for logging
 #include <typeinfo>    // Unused; possibly for debugging
 
 /****
  *
- * Pool is a template class that maintains 
- * a single, static pool (array) of objects of given class T.
+ * Pool is a template class that maintains
+ * a single, static pool of objects of given class T.
  * The T class should then extend the Pool<T>
  *
  ****/
-// Comment: Pool manages a fixed-size array of T objects with O(1) operations (Sec. 3.1.1).
+// Comment: Pool manages a chunked array of T objects with O(1) operations (Sec. 3.1.1).
+// Storage is allocated one fixed-size chunk at a time as the free list runs dry,
+// instead of one eager T::pool_size array at static-initialization time: a run
+// that stays at 100k tetras only ever backs two chunks, while the same binary
+// can be given a multi-gigabyte ceiling through reserve(). Labels stay plain
+// integers (chunk = label >> chunk_shift), so create/destroy/at remain O(1) and
+// nothing downstream changes.
 
 template<class T>
 class Pool {
 private:
-    static T *elements;  // Dynamic array of T objects
-    // Comment: Holds all instances of T; dynamically allocated in create_pool().
+    static T **chunks;   // Chunk pointer table; entry k backs labels [k*chunk_size, (k+1)*chunk_size)
+    // Comment: The table itself is sized to the configured capacity up front (a few
+    // hundred pointers), so growing only fills one slot and never relocates it —
+    // concurrent at() calls from other sweep threads stay safe without a lock.
     static int first;    // Index of first free cell
     // Comment: Points to next available slot (Sec. 3.1.1).
     static int total;    // Number of used cells
     // Comment: Tracks active objects.
-    static int capacity; // Total size of elements array
-    // Comment: Set by pool_size in derived class (Sec. 3.1.1).
+    static int capacity; // Configured maximum label count (reserve(); 0 until first use)
+    // Comment: Set by reserve() from the config file, or defaulted to T::pool_size.
+    static int allocated;  // Slots currently backed by chunks; grows chunk_size at a time
+    // Comment: The free list always terminates at ~allocated, so an empty list is
+    // detected as first == allocated and answered by backing one more chunk.
+
+    static std::mutex mtx;  // Guards the shared free list (first/total) and chunk growth
+    // Comment: create()/destroy() are called concurrently by the parallel sweep engine;
+    // the colored slab decomposition keeps the objects themselves thread-private, but
+    // the free list is global and needs this short critical section.
+
+    static int deferReclaim;  // Color phases currently deferring (> 0: park destroyed slots)
+    static std::vector<int> deferredSlots;  // Slots parked since deferral became active
+    // Comment: The free list is shared, so without deferral a slot destroyed by one
+    // sweep thread can be handed to another thread's create() within the same color
+    // phase. The new object then revalidates under the old Label (the Bags answer
+    // for the slot, not the object), and a stale phase-start snapshot entry steers
+    // a move into a foreign block. Parking slots until the phase join barrier makes
+    // every in-phase Label refer to the object it named at phase start, or to a
+    // dead slot that every Bag reports as absent. A count, not a flag: replicas
+    // run on concurrent threads over these shared pools, and their color phases
+    // overlap arbitrarily — parked slots may only come back once the LAST phase
+    // has hit its barrier, or its still-live snapshots see recycled Labels again.
 
     int next;  // Label or next free entry index
     // Comment: Per-object field; positive for active objects (their index), negative (~index) for free.
@@ -45,12 +76,46 @@ private:
     Pool() = default;  // Private default constructor
     // Comment: Prevents direct instantiation; only T can inherit.
 
+    static void reserveUnlocked(unsigned cap) {  // Sets the capacity; caller holds mtx
+        int nChunks = (cap + chunk_size - 1) / chunk_size;
+        int newCapacity = nChunks * chunk_size;  // Round up so every chunk is full-width
+        if (newCapacity == capacity) return;  // Batch mode: later configs repeat the ceiling
+        if (allocated > 0) {  // Chunks from an earlier run in this process stay resident
+            printf("pool: keeping capacity %d (resizing to %d needs a fresh process)\n", capacity, newCapacity);
+            return;
+        }
+        assert(total == 0);  // Must precede the first create()
+        capacity = newCapacity;
+        delete[] chunks;
+        chunks = new T*[nChunks]();  // Value-initialized: all entries null until grown
+    }
+
+    static void ensureReservedUnlocked() {  // Falls back to the compile-time default
+        static_assert(T::pool_size > 0, "Pool size not defined in child class");
+        // Comment: Enforces pool_size override in T (e.g., Vertex::pool_size = 3000000).
+        if (chunks == nullptr) reserveUnlocked(T::pool_size);
+    }
+
+    static void grow() {  // Backs one more chunk; caller holds mtx and the free list is empty
+        assert(allocated < capacity);  // Configured capacity exhausted otherwise
+        chunks[allocated >> chunk_shift] = new T[chunk_size];
+        for (int i = allocated; i < allocated + static_cast<int>(chunk_size); i++)
+            at(i).next = ~(i + 1);  // Mark all as free (~x = -(x+1))
+        first = allocated;  // The new chunk is the entire free list
+        allocated += chunk_size;
+        // Comment: O(chunk_size), amortized over chunk_size creates (Sec. 3.1.1).
+    }
+
 protected:
     static const unsigned pool_size = -1;  // Must be overridden in T
-    // Comment: Default -1 triggers static_assert if not set (Sec. 3.1.1).
-    // HPC Target [General #10]: Fixed size aids cache but limits scalability.
+    // Comment: Default capacity when reserve() is not called; the derived-class
+    // constants keep the historical sizes as defaults for unconfigured runs.
 
 public:
+    static const int chunk_shift = 16;                  // log2 of chunk_size
+    static const unsigned chunk_size = 1u << chunk_shift;  // Labels per chunk (65536)
+    // Comment: Power of two so the label-to-chunk split is a shift and a mask.
+
     Pool(const Pool&) = delete;           // Non-copyable
     Pool& operator=(const Pool&) = delete;
     Pool(Pool&&) = delete;                // Non-movable
@@ -82,48 +147,88 @@ public:
     operator Label() const { return Label{next}; }  // Converts Pool to Label
     // Comment: Returns current object’s index as Label.
 
-    static T* create_pool() {  // Initializes the pool
-        static_assert(T::pool_size > 0, "Pool size not defined in child class");
-        // Comment: Enforces pool_size override in T (e.g., Vertex::pool_size = 3000000).
-
-        capacity = T::pool_size;
-        elements = new T[capacity];  // Allocate pool
-        // HPC Target [General #10]: Fixed allocation; could be resized dynamically.
-
-        for (auto i = 0; i < capacity; i++)
-            elements[i].next = ~(i + 1);  // Mark all as free (~x = -(x+1))
-        // Comment: Initializes free list (Sec. 3.1.1).
+    static void reserve(unsigned cap) {  // Configures capacity before first use
+        std::lock_guard<std::mutex> lock(mtx);
+        reserveUnlocked(cap);
+        // Comment: Called from main() with the config-file pool keys; replaces the
+        // old compile-time-sized allocation at program start.
+    }
 
-        return elements;
+    static void reset() {  // Returns every slot to the free list; backed chunks stay resident
+        std::lock_guard<std::mutex> lock(mtx);
+        for (int i = 0; i < allocated; i++) at(i).next = ~(i + 1);  // Same layout grow() builds
+        first = 0;
+        total = 0;
+        // Comment: O(allocated) sequential pass, the batch driver's replacement for
+        // process teardown/relaunch (see Universe::reset()): the chunk table and
+        // backed chunks — the expensive part of startup — are reused by the next
+        // run. Leaks nothing (objects hold no owned resources) but invalidates
+        // every live Label, so all Universes must be gone before calling this.
     }
 
     static Label create() {  // Creates a new T object
+        std::lock_guard<std::mutex> lock(mtx);  // Free list is shared between sweep threads
+        ensureReservedUnlocked();
+        if (first == allocated) grow();  // Free list empty: back another chunk
         auto tmp = first;  // Take first free slot
-        assert(elements[tmp].next < 0);  // Verify it’s free
-        first = ~elements[tmp].next;     // Update first to next free
-        elements[tmp].next = tmp;        // Set object’s index (active)
-        total++;                         // Increment active count
-        return tmp;                      // Return Label
+        assert(at(tmp).next < 0);  // Verify it’s free
+        first = ~at(tmp).next;     // Update first to next free
+        at(tmp).next = tmp;        // Set object’s index (active)
+        total++;                   // Increment active count
+        return tmp;                // Return Label
         // Comment: O(1) allocation (Sec. 3.1.1).
     }
 
     static void destroy(Label i) {  // Destroys object at index i
-        elements[i].next = ~first;  // Link to previous free slot
-        first = i;                  // Update first free slot
-        total--;                    // Decrement active count
+        std::lock_guard<std::mutex> lock(mtx);  // Free list is shared between sweep threads
+        if (deferReclaim > 0) {  // Parallel sweep phase active: park the slot, object bytes stay intact
+            deferredSlots.push_back(i);
+            total--;
+            return;
+        }
+        at(i).next = ~first;  // Link to previous free slot
+        first = i;            // Update first free slot
+        total--;              // Decrement active count
         // Comment: O(1) deallocation (Sec. 3.1.1).
     }
 
-    static T& at(int i) { return elements[i]; }  // Access object at i
-    // Comment: Direct array access (Sec. 3.1.1).
+    static void beginDeferredReclaim() {  // Stop recycling slots until the matching barrier
+        std::lock_guard<std::mutex> lock(mtx);
+        deferReclaim++;
+    }
+
+    static void endDeferredReclaim() {  // Barrier: release parked slots once no phase defers
+        std::lock_guard<std::mutex> lock(mtx);
+        assert(deferReclaim > 0);  // Unbalanced begin/end
+        if (--deferReclaim > 0) return;  // Another replica's phase still holds snapshots
+        for (auto i : deferredSlots) {
+            at(i).next = ~first;
+            first = i;
+        }
+        deferredSlots.clear();  // Capacity is retained for the next phase
+        // Comment: Called between color phases of the parallel sweep engine, after
+        // the worker join. Reference-counted (see deferReclaim above): with several
+        // replicas sweeping in parallel over the shared pools, only the last phase
+        // out may return the parked slots, or a sibling's stale snapshot Label
+        // could be recycled mid-phase — the corruption deferral exists to prevent.
+    }
+
+    static T& at(int i) { return chunks[i >> chunk_shift][i & (chunk_size - 1)]; }
+    // Comment: Two-level array access; the chunk table stays resident in cache (Sec. 3.1.1).
 
     static int size() noexcept { return total; }  // Number of active objects
-    static int pool_capacity() noexcept { return capacity; }  // Total capacity
+    static int pool_capacity() {  // Configured capacity; applies the default when unconfigured
+        std::lock_guard<std::mutex> lock(mtx);
+        ensureReservedUnlocked();
+        return capacity;
+        // Comment: Bag and Marker size their per-label arrays from this, so they
+        // follow the configured capacity instead of the compile-time constants.
+    }
 
     void check_in_pool() {  // Validates object’s position
         assert(this->next >= 0);          // Must be active
-        assert(this->next < capacity);    // Within bounds
-        assert(this == elements + this->next);  // Matches index
+        assert(this->next < allocated);   // Within backed storage
+        assert(this == &at(this->next));  // Matches index
     }
     // Comment: Debug tool (Sec. 3.1.1).
 
@@ -142,13 +247,13 @@ public:
     public:
         Iterator(int i = 0, int cnt = 0) : i{i}, cnt{cnt} {}
 
-        T& operator*() { return elements[i]; }  // Dereference
+        T& operator*() { return at(i); }  // Dereference
         bool operator==(const Iterator& b) const { return cnt == b.cnt; }
         bool operator!=(const Iterator& b) const { return !operator==(b); }
 
         Iterator& operator++() {  // Move to next active object
             if (cnt < total - 1)
-                while (elements[++i].next < 0) {}  // Skip free slots
+                while (at(++i).next < 0) {}  // Skip free slots
             cnt++;
             return *this;
         }
@@ -156,8 +261,9 @@ public:
 
     struct Items {  // Helper for range-based iteration
         auto begin() {  // Start at first active object
+            if (total == 0) return Iterator{-1, 0};  // Empty pool: nothing to scan
             int i;
-            for (i = 0; elements[i].next < 0; i++) {}
+            for (i = 0; at(i).next < 0; i++) {}
             return Iterator{i, 0};
         }
         auto end() {  // End after all active objects
@@ -169,8 +275,13 @@ public:
     // Comment: Allows iteration over active T objects (Sec. 3.1.1).
 };
 
-template<class T> T* Pool<T>::elements = Pool<T>::create_pool();  // Static initialization
+template<class T> T **Pool<T>::chunks = nullptr;  // No storage until first use
 template<class T> int Pool<T>::first{0};
 template<class T> int Pool<T>::total{0};
-template<class T> int Pool<T>::capacity;
-// Comment: Initializes static members; elements allocated at program start.
\ No newline at end of file
+template<class T> int Pool<T>::capacity{0};
+template<class T> int Pool<T>::allocated{0};
+template<class T> std::mutex Pool<T>::mtx;
+template<class T> int Pool<T>::deferReclaim{0};
+template<class T> std::vector<int> Pool<T>::deferredSlots;
+// Comment: All chunks are demand-allocated; program start no longer pays for the
+// full configured capacity, and unused capacity never touches RSS.
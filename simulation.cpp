@@ -1,29 +1,38 @@
 // Copyright 2021 Joren Brunekreef, Daniel Nemeth and Andrzej Görlich
+#include <thread>          // For std::thread in the slab-parallel sweep engine
+#include <fstream>         // For checkpoint state files
+#include <cstdio>          // For std::rename (atomic checkpoint publish)
+#include <chrono>          // For the replay stage timings
+#include <algorithm>       // For std::min in the batched proposal loop
 #include "simulation.hpp"  // Simulation class definition
 #include "observable.hpp"  // Observable class definition
+#include "stats.hpp"       // Optional instrumentation hooks (make STATS=1)
 
-// Static member initializations (Sec. 3)
-double Simulation::k0 = 0;        // Gravitational coupling (Sec. 2.3)
-double Simulation::k3 = 0;        // Cosmological coupling (Sec. 2.3)
-std::default_random_engine Simulation::rng(0);  // RNG with default seed 0
-// TODO(JorenB): seed properly - Currently fixed; updated in start()
-// HPC Target [MPI #4]: Static RNG needs per-rank instances.
-int Simulation::targetVolume = 0;    // Target total volume (Sec. 2.4)
-int Simulation::target2Volume = 0;   // Secondary target volume
-double Simulation::epsilon = 0.00004;// Volume fixing strength (Sec. 2.4)
-bool Simulation::measuring = false;  // Measurement phase flag (Sec. 3.3)
-std::vector<Observable*> Simulation::observables3d;  // 3D observables
-std::vector<Observable*> Simulation::observables2d;  // 2D observables
-std::array<int, 3> Simulation::moveFreqs = {0, 0, 0}; // Move frequencies
+static const int32_t checkpointMagic = 0x544b4332;  // "2CKT"; leading tag of checkpoint state files
+// Comment: Bumped from "1CKT" when the autotuner state joined the record; a
+// mismatched tag falls back to a fresh run rather than misreading the stream.
+
+static const int32_t traceMagic = 0x43525431;  // "1TRC"; leading tag of move-trace files
+static const int traceArgc[10] = {0, 1, 1, 2, 2, 2, 3, 3, 0, 0};  // int32 args per record type
+// Comment: Move-trace record types (see Simulation::traceFile): 1 add, 2 delete,
+// 3 flip, 4/5 shift up/down, 6/7 ishift up/down, carrying the Label arguments of
+// the Universe::move*() call in order; 8 marks compactGeometry() and 9 marks
+// canonicalizeState(). The markers matter: relabeling changes every later
+// recorded label, and the canonical hints steer which tetras later moves walk
+// and free, so replay must interleave both at the recorded positions.
+
+// Comment: Member state lives per instance now; defaults are in the class definition.
 
 void Simulation::start(double k0_, double k3_, int sweeps, int thermalSweeps, int ksteps, int targetVolume_, int target2Volume_, int seed, std::string OutFile, int v1, int v2, int v3) {
-    Simulation::moveFreqs = {v1, v2, v3};  // Set move frequencies
+    moveFreqs = {v1, v2, v3};  // Set move frequencies
     // Comment: v1, v2, v3 likely weight add/delete, flip, shift moves (Sec. 2.3).
 
     targetVolume = targetVolume_;  // Set target volumes
     target2Volume = target2Volume_;
     k3 = k3_;  // Set couplings
     k0 = k0_;
+    updateActionConstants();  // Cache exp() factors for the move wrappers (Sec. 2.3)
+    bindMoveKernels();  // Select the (volfix_switch, strictness) kernel instantiations once
 
     for (auto o : observables3d) o->clear();  // Reset 3D observables
     for (auto o : observables2d) o->clear();  // Reset 2D observables
@@ -32,116 +41,218 @@ void Simulation::start(double k0_, double k3_, int sweeps, int thermalSweeps, in
     rng.seed(seed);  // Set RNG seed
     // Comment: Overrides default seed 0 (Sec. 2.1).
 
+    threadRngs.clear();  // Independent per-thread streams for the parallel sweep engine
+    for (int k = 0; k < nThreads; k++) threadRngs.emplace_back(seed + 7919 * (k + 1));
+
+    int startThermal = 1, startMeasure = 1;  // First sweep of each phase (resume skips completed ones)
+    if (resume) {
+        int phase = 0, sweep = 0;
+        if (readCheckpoint(OutFile, phase, sweep)) {
+            if (phase == 0) {
+                startThermal = sweep + 1;
+                if (autotune && thermalDone)  // Checkpoint from the early exit itself
+                    startThermal = thermalSweeps + 1;  // Continue into the measurement phase
+            } else {
+                startThermal = thermalSweeps + 1;  // Thermalization already done
+                startMeasure = sweep + 1;
+            }
+            printf("resumed from checkpoint: phase %d sweep %d k3: %g\n", phase, sweep, k3);
+        }
+    }
+    // Comment: readCheckpoint() restored the tuned k3 and every rng mid-stream, and
+    // main.cpp reloaded the checkpoint geometry, so the run continues bit-exactly.
+
+    if (traceFile != "") traceOpen();  // Record accepted moves (fresh serial runs only)
+
     measuring = true;  // Initially true; toggled later
     //////////////////////////////////////////////////////////////////////
     // ********************** START THERMAL SWEEPS ******************** //
     //////////////////////////////////////////////////////////////////////
     printf("k0: %g, k3: %g, epsilon: %g \t thermal: %d \t sweeps: %d Target: %d\t Target2d: %d\t \n", k0, k3, epsilon, thermalSweeps, sweeps, targetVolume, target2Volume);
 
-    for (int i = 1; i <= thermalSweeps; i++) {  // Thermalization phase (Sec. 3.3.2)
+    for (int i = startThermal; i <= thermalSweeps; i++) {  // Thermalization phase (Sec. 3.3.2)
         int total2v = 0;  // Total 2D volume (sum of slice sizes)
-        for (auto ss : Universe::sliceSizes) total2v += ss;
+        for (auto ss : universe.sliceSizes) total2v += ss;
 
-        double n31 = Universe::tetras31.size();  // Number of (3,1)-tetras
-        int n3 = Universe::tetrasAll.size();     // Total tetra count
+        double n31 = universe.tetras31.size();  // Number of (3,1)-tetras
+        int n3 = universe.tetrasAll.size();     // Total tetra count
 
         printf("Thermal: i: %d\t  Tetra::size: %d tetras31:  %g k3: %g \n", i, n3, n31, k3);
 
         performSweep(ksteps * 1000);  // Perform sweep (Sec. 3.3.2)
         // HPC Target [OpenMP #1]: Parallelize this loop.
 
+        if (universe.checkMode) universe.runChecks();  // Tiered verification (universe.hpp)
+
         tune();  // Adjust k3 (Sec. 3.3.1)
 
-        if (i % (thermalSweeps / 10) == 0)  // Periodic export
-            Universe::exportGeometry(OutFile);
+        bool finishThermal = autotune && thermalDone && i < thermalSweeps;
+        // Comment: The autotuner's equilibrium test held for enough consecutive
+        // sweeps; finish this sweep's bookkeeping (forced export and checkpoint,
+        // so the saved state matches the phase boundary) and end the phase early.
+
+        if (i % (thermalSweeps / 10) == 0 || finishThermal)  // Periodic export (written off-thread)
+            universe.exportGeometryAsync(OutFile);
 
         prepare();  // Update geometry (Sec. 3.2)
-        for (auto o : observables3d) o->measure();  // Measure 3D observables
-        // HPC Target [OpenMP #2]: Parallelize measurement loop.
+        {
+            CDT_STATS_PHASE_SCOPE(OBSERVE3D);
+            measureAll(observables3d);  // Measure 3D observables (pooled when >1)
+        }
+
+        if (i % (thermalSweeps / 10) == 0 || finishThermal)  // Full-state checkpoint, after this sweep's measurements
+            writeCheckpoint(OutFile, 0, i);
+
+        CDT_STATS_EMIT(OutFile, 0, i);  // One cumulative record per sweep when enabled
+
+        if (finishThermal) {
+            printf("Thermal: equilibrated at sweep %d of %d\n", i, thermalSweeps);
+            break;
+        }
     }
 
     //////////////////////////////////////////////////////////////////////
     // ********************** END THERMAL SWEEPS ******************** //
     //////////////////////////////////////////////////////////////////////
+    measureJoin();  // Relabeling would invalidate an in-flight stage's snapshot
+    if (startMeasure == 1) {  // Skipped when resuming mid-measurement: it already ran there
+        universe.compactGeometry();  // Relabel in BFS order before the traversal-heavy phase
+        if (traceActive) traceRecord(8, -1, -1, -1);  // Replay must relabel here too
+    }
+    // Comment: Thermalization churns the Pool free list until adjacent simplices are
+    // scattered; compacting here makes the measurement sweeps and observables walk
+    // near-contiguous memory (Sec. 3.1.1).
+
     printf("======\n");
     // ********************** START MEASURE SWEEPS ****************** //
     printf("k0: %g, k3: %g, epsilon: %g\n", k0, k3, epsilon);
 
-    for (int i = 1; i <= sweeps; i++) {  // Measurement phase (Sec. 3.3.3)
+    for (int i = startMeasure; i <= sweeps; i++) {  // Measurement phase (Sec. 3.3.3)
         int total2v = 0;
-        for (auto ss : Universe::sliceSizes) total2v += ss;
-        int avg2v = total2v / Universe::nSlices;  // Average slice size
+        for (auto ss : universe.sliceSizes) total2v += ss;
+        int avg2v = total2v / universe.nSlices;  // Average slice size
 
-        printf("SWEEPS: i: %d\t Target: %d\t Target2d: %d\t CURRENT: %d avgslice: %d\n", i, targetVolume, target2Volume, Tetra::size(), avg2v);
+        printf("SWEEPS: i: %d\t Target: %d\t Target2d: %d\t CURRENT: %d avgslice: %d\n", i, targetVolume, target2Volume, universe.tetrasAll.size(), avg2v);
 
         performSweep(ksteps * 1000);  // Perform sweep
         // HPC Target [OpenMP #1]: Parallelize this loop.
 
-        if (i % (sweeps / 10) == 0)  // Periodic export
-            Universe::exportGeometry(OutFile);
+        if (universe.checkMode) universe.runChecks();  // Tiered verification (universe.hpp)
+
+        if (i % (sweeps / 10) == 0)  // Periodic export (written off-thread)
+            universe.exportGeometryAsync(OutFile);
 
         if (observables3d.size() > 0) {  // Measure 3D observables
-            int vol_switch = Universe::volfix_switch;
+            int vol_switch = universe.volfix_switch;
             if (targetVolume > 0) {  // Volume fixing loop
-                int cmp;
-                do {
-                    attemptMove();
-                    cmp = vol_switch == 0 ? Universe::tetras31.size() : Universe::tetrasAll.size();
-                } while (cmp != targetVolume);  // Adjust until target hit
+                int cmp = vol_switch == 0 ? universe.tetras31.size() : universe.tetrasAll.size();
+                while (cmp != targetVolume) {  // Signed distance from the Bag sizes: O(1) per attempt
+                    attemptVolfixMove(targetVolume > cmp ? 1 : -1, false);
+                    cmp = vol_switch == 0 ? universe.tetras31.size() : universe.tetrasAll.size();
+                }
+                // Comment: Only volume-changing proposals, biased toward the target;
+                // flips (volume-neutral) no longer burn attempts between measurements.
             }
 
             prepare();  // Update geometry
             // HPC Target [OpenMP #3]: Parallelize if BFS involved.
-            for (auto o : observables3d) o->measure();  // Measure
-            // HPC Target [OpenMP #2]: Parallelize this loop.
+            {
+                CDT_STATS_PHASE_SCOPE(OBSERVE3D);
+                measureAll(observables3d);  // Measure (pooled when >1)
+            }
         }
 
         if (target2Volume > 0) {  // Measure 2D observables
-            bool hit = false;
-            do {
-                attemptMove();
-                for (auto s : Universe::sliceSizes) {
-                    if (s == target2Volume) { hit = true; break; }
-                }
-            } while (!hit);  // Adjust until a slice matches target2Volume
+            universe.setSliceTarget(target2Volume);  // Arm the counters: one O(nSlices) scan per sweep
+            while (!universe.sliceAtTarget())  // Flag maintained by move26/move62 (Sec. 2.4)
+                attemptVolfixMove(universe.sliceTargetDirection(), true);
+            universe.setSliceTarget(0);  // Disarm: parallel sweep threads must not race the counters
+            // Comment: Event-driven replacement for the old attempt-then-rescan spin:
+            // while armed the hit test is O(1) per attempt, and the proposal mix is
+            // biased toward add/delete, the only moves that change a slice size.
 
             prepare();
-            for (auto o : observables2d) o->measure();
-            // HPC Target [OpenMP #2]: Parallelize this loop.
+            {
+                CDT_STATS_PHASE_SCOPE(OBSERVE2D);
+                measureAll(observables2d);  // Measure (pooled when >1)
+            }
+        }
+
+        if (i % (sweeps / 10) == 0) {  // Checkpoint cadence, after this sweep's measurements
+            measureJoin();  // Join before relabeling invalidates the stage's snapshot
+            universe.compactGeometry();  // Periodic re-compaction: move churn re-scatters labels
+            if (traceActive) traceRecord(8, -1, -1, -1);  // Replay must relabel here too
+            writeCheckpoint(OutFile, 1, i);  // Snapshot the compacted state
         }
+
+        CDT_STATS_EMIT(OutFile, 1, i);  // One cumulative record per sweep when enabled
     }
+
+    measureJoin();  // The final sweep's stage may still be in flight
+    universe.finishExports();  // Join a still-running background export before returning
+    traceClose();  // Flush the move trace, if one was recorded
     // HPC Targets: [MPI #4] (distribute runs), [GPU #7] (accelerate moves), [General #12] (tune sweep size)
 }
 
-int Simulation::attemptMove() {  // Attempts a random move (Sec. 2.1)
+Tetra::Label Simulation::pickSeedTetra(Xoshiro256pp &gen, const MoveCandidates *cand) {
+    if (cand == nullptr) return universe.tetras31.pick(gen);  // Serial path: global Bag
+    if (cand->tetras31.empty()) return -1;
+    auto t = cand->tetras31[gen.bounded(cand->tetras31.size())];
+    // The snapshot is taken at phase start; this thread's own earlier moves may have
+    // destroyed the entry since, and a slot destroyed before the phase can have been
+    // recycled into a different block's (3,1) — reject both before any mutation.
+    if (t < 0 || !universe.tetras31.contains(t)) return -1;
+    if (!seedInBlock(cand, t->time)) return -1;  // Slot recycled outside the seed range
+    return t;
+}
+
+Vertex::Label Simulation::pickSeedVertex(Xoshiro256pp &gen, const MoveCandidates *cand) {
+    if (cand == nullptr) {  // Serial path: delete-candidate Bag
+        if (universe.verticesSix.size() == 0) return -1;  // No deletable vertex yet
+        return universe.verticesSix.pick(gen);
+    }
+    if (cand->vertices.empty()) return -1;
+    auto v = cand->vertices[gen.bounded(cand->vertices.size())];
+    if (v < 0 || !universe.verticesSix.contains(v)) return -1;  // Stale snapshot entry
+    if (!seedInBlock(cand, v->time)) return -1;  // Slot recycled outside the seed range
+    return v;
+}
+
+template <int VS, int S>
+int Simulation::attemptMove(Xoshiro256pp &gen, const MoveCandidates *cand) {  // Attempts a random move (Sec. 2.1)
     std::array<int, 3> cumFreqs = {moveFreqs[0], moveFreqs[0] + moveFreqs[1], moveFreqs[0] + moveFreqs[1] + moveFreqs[2]};
     int freqTotal = moveFreqs[0] + moveFreqs[1] + moveFreqs[2];  // Total frequency
 
-    std::uniform_int_distribution<> moveGen(0, freqTotal - 1);  // Move selector
-    std::uniform_int_distribution<> binGen(0, 1);               // Binary selector
-
-    int move = moveGen(rng);  // Random move index
+    int move = gen.bounded(freqTotal);  // Random move index
 
     if (move < cumFreqs[0]) {  // Add/Delete moves (Sec. 2.3.1)
-        if (binGen(rng) == 0) {
-            if (moveAdd()) return 1; else return -1;  // 1: success, -1: fail
+        if (gen.bounded(2) == 0) {
+            auto t = pickSeedTetra(gen, cand);
+            if (t < 0) return 0;  // Stale snapshot pick; no move attempted
+            if (moveAdd<VS>(t, gen)) return 1; else return -1;  // 1: success, -1: fail
         } else {
-            if (moveDelete()) return 2; else return -2;
+            auto v = pickSeedVertex(gen, cand);
+            if (v < 0) return 0;
+            if (moveDelete<VS, S>(v, gen)) return 2; else return -2;
         }
     } else if (cumFreqs[0] <= move && move < cumFreqs[1]) {  // Flip move (Sec. 2.3.2)
-        if (moveFlip()) return 3; else return -3;
+        auto t = pickSeedTetra(gen, cand);
+        if (t < 0) return 0;
+        if (moveFlip<S>(t, gen)) return 3; else return -3;
     } else if (cumFreqs[1] <= move) {  // Shift/Ishift moves (Sec. 2.3.3)
-        if (binGen(rng) == 0) {
-            if (binGen(rng) == 0) {
-                if (moveShift()) return 4; else return -4;  // Upward shift
+        auto t = pickSeedTetra(gen, cand);
+        if (t < 0) return 0;
+        if (gen.bounded(2) == 0) {
+            if (gen.bounded(2) == 0) {
+                if (moveShift<VS>(t, gen)) return 4; else return -4;  // Upward shift
             } else {
-                if (moveShiftD()) return 4; else return -4; // Downward shift
+                if (moveShiftD<VS>(t, gen)) return 4; else return -4; // Downward shift
             }
         } else {
-            if (binGen(rng) == 0) {
-                if (moveShiftI()) return 5; else return -5;  // Upward ishift
+            if (gen.bounded(2) == 0) {
+                if (moveShiftI<VS>(t, gen)) return 5; else return -5;  // Upward ishift
             } else {
-                if (moveShiftID()) return 5; else return -5; // Downward ishift
+                if (moveShiftID<VS>(t, gen)) return 5; else return -5; // Downward ishift
             }
         }
     }
@@ -149,21 +260,244 @@ int Simulation::attemptMove() {  // Attempts a random move (Sec. 2.1)
     // HPC Target [GPU #7]: Batch move attempts on GPU.
 }
 
+template <int VS, int S>
+void Simulation::attemptMoveBatch(Xoshiro256pp &gen, int count, std::vector<int> &moves, std::vector<int> &failed_moves) {
+    std::array<int, 3> cumFreqs = {moveFreqs[0], moveFreqs[0] + moveFreqs[1], moveFreqs[0] + moveFreqs[1] + moveFreqs[2]};
+    int freqTotal = moveFreqs[0] + moveFreqs[1] + moveFreqs[2];  // Total frequency
+
+    proposalBuf.resize(count);
+    for (int j = 0; j < count; j++) {  // Generation pass: same draw sequence as attemptMove()
+        Proposal &p = proposalBuf[j];
+        p.sub = 0;
+        int move = gen.bounded(freqTotal);
+
+        if (move < cumFreqs[0]) {  // Add/Delete (Sec. 2.3.1)
+            if (gen.bounded(2) == 0) {
+                p.move = 1;
+                p.seed = universe.tetras31.pick(gen);
+            } else {
+                p.move = 2;
+                p.seed = universe.verticesSix.size() == 0 ? -1 : static_cast<int>(universe.verticesSix.pick(gen));
+            }
+        } else if (cumFreqs[0] <= move && move < cumFreqs[1]) {  // Flip (Sec. 2.3.2)
+            p.move = 3;
+            p.seed = universe.tetras31.pick(gen);
+        } else {  // Shift/Ishift (Sec. 2.3.3)
+            p.seed = universe.tetras31.pick(gen);
+            p.move = gen.bounded(2) == 0 ? 4 : 5;
+            p.sub = gen.bounded(2);
+        }
+
+        if (p.seed >= 0) {  // Warm the seed's pool slot before the execution pass needs it
+            const char *slot = p.move == 2
+                ? reinterpret_cast<const char *>(&Vertex::at(p.seed))
+                : reinterpret_cast<const char *>(&Tetra::at(p.seed));
+            __builtin_prefetch(slot);
+            __builtin_prefetch(slot + 64);  // Tetra spans two cache lines (tnbr/vs tables)
+        }
+    }
+    // Comment: The Bag picks and pool loads of consecutive attempts are independent
+    // here, so the prefetches overlap; the serial path issues them one dependent
+    // chain at a time and stalls on each, which dominates attempt cost for the
+    // ~50% of attempts that fail their preconditions.
+
+    for (int j = 0; j < count; j++) {  // Execution pass over the warmed batch
+        const Proposal &p = proposalBuf[j];
+        int move_num = 0;
+
+        bool live = p.seed >= 0 && (p.move == 2
+            ? universe.verticesSix.contains(p.seed)
+            : universe.tetras31.contains(p.seed));
+        // Comment: An earlier move in this batch may have destroyed the seed; a
+        // re-validated slot is a live current member of its Bag, so the proposal
+        // distribution matches a fresh pick up to the (rare) in-batch kills.
+
+        if (live) {
+            switch (p.move) {
+                case 1: move_num = moveAdd<VS>(p.seed, gen) ? 1 : -1; break;
+                case 2: move_num = moveDelete<VS, S>(p.seed, gen) ? 2 : -2; break;
+                case 3: move_num = moveFlip<S>(p.seed, gen) ? 3 : -3; break;
+                case 4:
+                    if (p.sub == 0) move_num = moveShift<VS>(p.seed, gen) ? 4 : -4;
+                    else move_num = moveShiftD<VS>(p.seed, gen) ? 4 : -4;
+                    break;
+                case 5:
+                    if (p.sub == 0) move_num = moveShiftI<VS>(p.seed, gen) ? 5 : -5;
+                    else move_num = moveShiftID<VS>(p.seed, gen) ? 5 : -5;
+                    break;
+            }
+        }
+
+        int move = abs(move_num);
+        moves[move]++;
+        if (move_num < 0) failed_moves[move]++;
+    }
+    // Comment: Same statistics convention as the serial loop; stale seeds count as
+    // move type 0 (no move attempted), matching attemptMove()'s snapshot path.
+}
+
+template <int VS, int S>
+int Simulation::attemptVolfixMove(int direction, bool sliceMode) {  // Biased volume-targeting proposal (Sec. 2.4)
+    if (direction == 0 || rng.bounded(2) == 0) return attemptMove<VS, S>(rng, nullptr);
+    // Comment: Half the attempts stay unbiased. Deletes only apply to six-vertices,
+    // which are mostly the vertices the loop itself just added, so a pure add/delete
+    // stream freezes the profile in place; the interleaved flips/shifts keep creating
+    // fresh delete candidates and diffusing volume between slices.
+
+    if (sliceMode || universe.volfix_switch == 0 || rng.bounded(2) == 0) {  // Add/delete: the ±2 steps
+        if (direction > 0) {
+            auto t = pickSeedTetra(rng, nullptr);
+            if (moveAdd<VS>(t, rng)) return 1; else return -1;
+        }
+        auto v = pickSeedVertex(rng, nullptr);
+        if (v < 0) return attemptMove<VS, S>(rng, nullptr);  // No deletable vertex yet: churn until one appears
+        if (moveDelete<VS, S>(v, rng)) return 2; else return -2;
+    }
+
+    auto t = pickSeedTetra(rng, nullptr);  // tetrasAll targeting also needs the ±1 steps
+    if (direction > 0) {
+        if (rng.bounded(2) == 0) { if (moveShift<VS>(t, rng)) return 4; else return -4; }
+        if (moveShiftD<VS>(t, rng)) return 4; else return -4;
+    }
+    if (rng.bounded(2) == 0) { if (moveShiftI<VS>(t, rng)) return 5; else return -5; }
+    if (moveShiftID<VS>(t, rng)) return 5; else return -5;
+    // Comment: Same return convention as attemptMove(). The Metropolis tests inside
+    // the wrappers are unchanged; only the proposal mix is skewed, which is fine for
+    // the volfix projection (it fabricates no new accepted-state statistics, it just
+    // reaches the target volume in fewer attempts).
+}
+
+template <int VS, int S>
+void Simulation::bindMoveKernels() {  // Binds the specialized kernels for this run's config
+    attemptMoveKernel = &Simulation::attemptMove<VS, S>;
+    attemptMoveBatchKernel = &Simulation::attemptMoveBatch<VS, S>;
+    volfixMoveKernel = &Simulation::attemptVolfixMove<VS, S>;
+}
+
+void Simulation::bindMoveKernels() {  // Runtime-to-compile-time dispatch, once per start()
+    int s = universe.strictness;
+    if (s < 0) s = 0;
+    if (s > 3) s = 3;  // Levels above 3 add no further checks (Sec. 1.3)
+    if (universe.volfix_switch == 0) {
+        switch (s) {
+            case 0: bindMoveKernels<0, 0>(); break;
+            case 1: bindMoveKernels<0, 1>(); break;
+            case 2: bindMoveKernels<0, 2>(); break;
+            default: bindMoveKernels<0, 3>(); break;
+        }
+    } else {
+        switch (s) {
+            case 0: bindMoveKernels<1, 0>(); break;
+            case 1: bindMoveKernels<1, 1>(); break;
+            case 2: bindMoveKernels<1, 2>(); break;
+            default: bindMoveKernels<1, 3>(); break;
+        }
+    }
+    // Comment: Both settings are fixed for the lifetime of a run, yet were branched
+    // on inside every single move attempt; one indirect call per attempt replaces
+    // them and lets the compiler fold the fixing-term and strictness code per kernel.
+}
+
+void Simulation::sweepAttemptsParallel(int n, std::vector<int> &moves, std::vector<int> &failed_moves) {
+    partitionOffset = (partitionOffset + 1) % universe.nSlices;  // Block boundaries migrate every sweep
+    int offset = partitionOffset;
+
+    int nBlocks = 2 * nThreads;  // Two interleaved colors of nThreads blocks each
+    int nSlices = universe.nSlices;
+    int perThread = n / nBlocks;  // Attempts per block; both colors together approximate n
+
+    for (int color = 0; color < 2; color++) {  // Phases alternate, separated by a join barrier
+        std::vector<MoveCandidates> cands(nThreads);
+        std::vector<int> slabOwner(nSlices, -1);  // Interior slab -> owning thread
+
+        for (int k = 0; k < nThreads; k++) {  // Block b covers [b*nSlices/nBlocks, (b+1)*nSlices/nBlocks - 1]
+            int b = 2 * k + color;
+            int lo = (b * nSlices) / nBlocks;
+            int hi = ((b + 1) * nSlices) / nBlocks - 1;
+            // One-slab buffer at each block edge: a move seeded at slab s only writes
+            // slabs s-1..s and vertex times s-1..s+1, so interior seeds keep all writes
+            // inside the block, and same-color blocks never share a slice.
+            cands[k].slabLo = (lo + 1 + offset) % nSlices;
+            cands[k].slabHi = (hi - 1 + offset) % nSlices;
+            for (int s = lo + 1; s <= hi - 1; s++) slabOwner[(s + offset) % nSlices] = k;
+        }
+
+        for (auto t : universe.tetras31) {  // One pass builds all per-thread seed snapshots
+            int k = slabOwner[t->time];
+            if (k >= 0) cands[k].tetras31.push_back(t);
+        }
+        for (auto v : universe.verticesSix) {
+            int k = slabOwner[v->time];
+            if (k >= 0) cands[k].vertices.push_back(v);
+        }
+
+        Pool<Tetra>::beginDeferredReclaim();   // No slot recycling while snapshots are live:
+        Pool<Vertex>::beginDeferredReclaim();  // see the deferReclaim field in pool.hpp
+
+        std::vector<std::vector<int>> localMoves(nThreads, std::vector<int>(6, 0));
+        std::vector<std::vector<int>> localFailed(nThreads, std::vector<int>(6, 0));
+        std::vector<std::thread> workers;
+        for (int k = 0; k < nThreads; k++) {
+            workers.emplace_back([this, k, perThread, &cands, &localMoves, &localFailed]() {
+                for (int i = 0; i < perThread; i++) {
+                    int move_num = (this->*attemptMoveKernel)(threadRngs[k], &cands[k]);
+                    int move = abs(move_num);
+                    localMoves[k][move]++;
+                    if (move_num < 0) localFailed[k][move]++;
+                }
+            });
+        }
+        for (auto &w : workers) w.join();
+
+        Pool<Tetra>::endDeferredReclaim();   // Snapshots are dead past the barrier;
+        Pool<Vertex>::endDeferredReclaim();  // parked slots rejoin the free list
+
+        for (int k = 0; k < nThreads; k++) {  // Merge per-thread statistics
+            for (int m = 0; m < 6; m++) {
+                moves[m] += localMoves[k][m];
+                failed_moves[m] += localFailed[k][m];
+            }
+        }
+    }
+}
+
 std::vector<int> Simulation::performSweep(int n) {  // Executes n move attempts (Sec. 3.3.2, 3.3.3)
     std::vector<int> moves(6, 0);      // Successful moves (0 unused, 1-5 for types)
     std::vector<int> failed_moves(6, 0); // Failed moves
 
-    for (int i = 0; i < n; i++) {  // Attempt n moves
-        int move_num = attemptMove();
-        int move = abs(move_num);  // Move type (1-5)
-        moves[move]++;             // Count attempt
-        if (move_num < 0) failed_moves[move]++;  // Count failure
+    bool parallel = nThreads > 1 && universe.nSlices >= 6 * nThreads;  // Blocks need >= 3 slabs for interior seeds
+    if (nThreads > 1 && !parallel && !warnedSerialFallback) {
+        printf("performSweep: %d threads need nSlices >= %d (have %d); running the serial loop\n",
+               nThreads, 6 * nThreads, universe.nSlices);
+        fflush(stdout);
+        warnedSerialFallback = true;
+        // Comment: Loud fallback — a silently serial run reads like a tested
+        // parallel one, and its outputs masquerade as parallel-path coverage.
+    }
+
+    if (parallel) {
+        sweepAttemptsParallel(n, moves, failed_moves);
+    } else if (proposalBatch > 1) {  // Batched proposal pipeline (see simulation.hpp)
+        for (int i = 0; i < n; i += proposalBatch) {
+            int count = std::min(proposalBatch, n - i);
+            (this->*attemptMoveBatchKernel)(rng, count, moves, failed_moves);
+        }
+    } else {
+        for (int i = 0; i < n; i++) {  // Attempt n moves
+            int move_num = attemptMove();
+            int move = abs(move_num);  // Move type (1-5)
+            moves[move]++;             // Count attempt
+            if (move_num < 0) failed_moves[move]++;  // Count failure
+        }
     }
-    // HPC Target [OpenMP #1]: Parallelize this loop.
 
     int m1 = moves[1] + moves[2];  // Add/Delete total
     int m2 = moves[3];             // Flip total
     int m3 = moves[4] + moves[5];  // Shift/Ishift total
+    lastSweepNetGrow = (moves[1] - failed_moves[1]) - (moves[2] - failed_moves[2]);
+    // Comment: Net accepted (2,6) minus (6,2) moves: the drift of the volume
+    // random walk over this sweep, consumed by the autotuner's equilibrium test.
+
     int f1 = failed_moves[1] + failed_moves[2];  // Failed Add/Delete
     int f2 = failed_moves[3];                    // Failed Flip
     int f3 = failed_moves[4] + failed_moves[5];  // Failed Shift/Ishift
@@ -182,184 +516,465 @@ std::vector<int> Simulation::performSweep(int n) {  // Executes n move attempts
     // HPC Target [General #12]: Adjust n dynamically based on r1, r2, r3.
 }
 
-bool Simulation::moveAdd() {  // Attempts (2,6)-move (Sec. 2.3.1)
-    double n31 = Universe::tetras31.size();
-    int n3 = Universe::tetrasAll.size();
-    int vol_switch = Universe::volfix_switch;
-
-    double edS = exp(1 * k0 - 4 * k3);  // Action change (Sec. 2.3.1, eq. 25)
-    double rg = n31 / (n31 + 2.0);     // Selection probability ratio
+template <int VS>
+bool Simulation::moveAdd(Tetra::Label t, Xoshiro256pp &gen) {  // Attempts (2,6)-move (Sec. 2.3.1)
+    CDT_STATS_MOVE_SCOPE(ADD);
+    double n31 = universe.tetras31.size();  // Racy O(1) read in parallel mode; absorbed by the volfix term
+    int n3 = universe.tetrasAll.size();
+
+    double edS = edsAdd;  // Cached exp(k0 - 4 k3) (Sec. 2.3.1, eq. 25)
+    // Selection probability ratio: forward picks t from tetras31, reverse picks the
+    // new vertex from verticesSix. Its post-move size is predictable: the new vertex
+    // joins, and any of the five vertices gaining coordination drops out.
+    double nSixAfter = universe.verticesSix.size() + 1;
+    for (auto v : {t->vs[0], t->vs[1], t->vs[2], t->vs[3], t->tnbr[3]->vs[0]})
+        if (universe.verticesSix.contains(v)) nSixAfter -= 1;
+    double rg = n31 / nSixAfter;       // Selection probability ratio
     double ar = edS * rg;              // Acceptance ratio
 
-    if (vol_switch == 0) {  // Fix (3,1) count
-        if (targetVolume > 0) ar *= exp(4 * epsilon * (targetVolume - n31 - 1));  // Volume fixing term
+    if (VS == 0) {  // Fix (3,1) count (VS: compile-time volfix mode, dead branch folded)
+        if (targetVolume > 0) ar *= volfixExp(4 * (targetVolume - static_cast<int>(n31) - 1));  // Volume fixing term
     } else {  // Fix total count
-        if (targetVolume > 0) ar *= exp(8 * epsilon * (targetVolume - n3 - 2));
+        if (targetVolume > 0) ar *= volfixExp(8 * (targetVolume - n3 - 2));
     }
 
     if (ar < 1.0) {  // Metropolis acceptance (Sec. 2.2)
-        std::uniform_real_distribution<> uniform(0.0, 1.0);
-        if (uniform(rng) > ar) return false;
+        if (gen.uniform() > ar) { CDT_STATS_METRO_REJECT(ADD); return false; }
     }
 
-    Tetra::Label t = Universe::tetras31.pick();  // Random (3,1)-tetra
-    Universe::move26(t);  // Perform move
+    CDT_STATS_RESULT(ADD, universe.move26(t));  // Perform move
+    if (traceActive) traceRecord(1, t, -1, -1);
     return true;
     // HPC Target [GPU #7]: Batch on GPU.
 }
 
-bool Simulation::moveDelete() {  // Attempts (6,2)-move (Sec. 2.3.1)
-    double n31 = Universe::tetras31.size();
-    int n3 = Universe::tetrasAll.size();
-    int vol_switch = Universe::volfix_switch;
+template <int VS, int S>
+bool Simulation::moveDelete(Vertex::Label v, Xoshiro256pp &gen) {  // Attempts (6,2)-move (Sec. 2.3.1)
+    CDT_STATS_MOVE_SCOPE(DEL);
+    double n31 = universe.tetras31.size();
+    int n3 = universe.tetrasAll.size();
 
-    double edS = exp(-1 * k0 + 4 * k3);  // Action change (Sec. 2.3.1, eq. 27)
-    double rg = n31 / (n31 - 2.0);      // Selection probability ratio
+    double edS = edsDelete;  // Cached exp(-k0 + 4 k3) (Sec. 2.3.1, eq. 27)
+    double nSix = universe.verticesSix.size();  // Forward picks v from verticesSix
+    double rg = nSix / (n31 - 2.0);     // Selection probability ratio (reverse picks from tetras31)
     double ar = edS * rg;
 
-    if (vol_switch == 0) {
-        if (targetVolume > 0) ar *= exp(-4 * epsilon * (targetVolume - n31 - 1));
+    if (VS == 0) {
+        if (targetVolume > 0) ar *= volfixExp(-4 * (targetVolume - static_cast<int>(n31) - 1));
     } else {
-        if (targetVolume > 0) ar *= exp(-8 * epsilon * (targetVolume - n3 - 2));
+        if (targetVolume > 0) ar *= volfixExp(-8 * (targetVolume - n3 - 2));
     }
 
     if (ar < 1.0) {
-        std::uniform_real_distribution<> uniform(0.0, 1.0);
-        if (uniform(rng) > ar) return false;
+        if (gen.uniform() > ar) { CDT_STATS_METRO_REJECT(DEL); return false; }
     }
 
-    Vertex::Label v = Universe::verticesAll.pick();  // Random vertex
-    if (v->cnum != 6 || v->scnum != 3) return false; // Check move condition (Sec. 2.3.1)
+    assert(v->cnum == 6 && v->scnum == 3);  // Guaranteed by the verticesSix candidate Bag (Sec. 2.3.1)
 
-    Universe::move62(v);
+    CDT_STATS_RESULT(DEL, universe.move62<S>(v));
+    if (traceActive) traceRecord(2, v, -1, -1);
     return true;
     // HPC Target [GPU #7]: Batch on GPU.
 }
 
-bool Simulation::moveFlip() {  // Attempts (4,4)-move (Sec. 2.3.2)
-    Tetra::Label t012 = Universe::tetras31.pick();  // Random (3,1)-tetra
-    std::uniform_int_distribution<> neighborGen(0, 2);
-    Tetra::Label t230 = t012->tnbr[neighborGen(rng)];  // Random spatial neighbor
+template <int S>
+bool Simulation::moveFlip(Tetra::Label t012, Xoshiro256pp &gen) {  // Attempts (4,4)-move (Sec. 2.3.2)
+    CDT_STATS_MOVE_SCOPE(FLIP);
+    Tetra::Label t230 = t012->tnbr[gen.bounded(3)];  // Random spatial neighbor
 
-    if (!t230->is31()) return false;  // Must be (3,1)
-    if (!t012->tnbr[3]->neighborsTetra(t230->tnbr[3])) return false;  // Check vertical neighbors
+    if (Tetra::typeOf(t230) != Tetra::THREEONE) { CDT_STATS_GEOM_REJECT(FLIP); return false; }  // Must be (3,1); packed type read
+    if (!t012->tnbr[3]->neighborsTetra(t230->tnbr[3])) { CDT_STATS_GEOM_REJECT(FLIP); return false; }  // Check vertical neighbors
 
-    return Universe::move44(t012, t230);  // No Metropolis step (ar=1, Sec. 2.3.2)
+    bool ok = CDT_STATS_RESULT(FLIP, universe.move44<S>(t012, t230));  // No Metropolis step (ar=1, Sec. 2.3.2)
+    if (ok && traceActive) traceRecord(3, t012, t230, -1);
+    return ok;
     // HPC Target [GPU #7]: Batch on GPU.
 }
 
-bool Simulation::moveShift() {  // Attempts (2,3)-move upward (Sec. 2.3.3)
-    double edS = exp(-1.0 * k3);  // Action change (Sec. 2.3.3, eq. 28)
+template <int VS>
+bool Simulation::moveShift(Tetra::Label t, Xoshiro256pp &gen) {  // Attempts (2,3)-move upward (Sec. 2.3.3)
+    CDT_STATS_MOVE_SCOPE(SHIFT);
+    double edS = edsShift;  // Cached exp(-k3) (Sec. 2.3.3, eq. 28)
     double rg = 1.0;              // Selection probability ratio
     double ar = edS * rg;
-    int n3 = Universe::tetrasAll.size();
-    int vol_switch = Universe::volfix_switch;
+    int n3 = universe.tetrasAll.size();
 
-    if (vol_switch == 1 && targetVolume > 0) ar *= exp(epsilon * (2 * targetVolume - 2 * n3 - 1));
+    if (VS == 1 && targetVolume > 0) ar *= volfixExp(2 * targetVolume - 2 * n3 - 1);
 
     if (ar < 1.0) {
-        std::uniform_real_distribution<> uniform(0.0, 1.0);
-        if (uniform(rng) > ar) return false;
+        if (gen.uniform() > ar) { CDT_STATS_METRO_REJECT(SHIFT); return false; }
     }
 
-    Tetra::Label t = Universe::tetras31.pick();
-    std::uniform_int_distribution<> neighborGen(0, 2);
-    Tetra::Label tn = t->tnbr[neighborGen(rng)];
+    Tetra::Label tn = t->tnbr[gen.bounded(3)];
 
-    if (!tn->is22()) return false;  // Must be (2,2)-tetra
+    if (Tetra::typeOf(tn) != Tetra::TWOTWO) { CDT_STATS_GEOM_REJECT(SHIFT); return false; }  // Must be (2,2)-tetra; packed type read
 
-    return Universe::move23u(t, tn);
+    bool ok = CDT_STATS_RESULT(SHIFT, universe.move23u(t, tn));
+    if (ok && traceActive) traceRecord(4, t, tn, -1);
+    return ok;
     // HPC Target [GPU #7]: Batch on GPU.
 }
 
-bool Simulation::moveShiftD() {  // Attempts (2,3)-move downward
-    double edS = exp(-1.0 * k3);
+template <int VS>
+bool Simulation::moveShiftD(Tetra::Label tv, Xoshiro256pp &gen) {  // Attempts (2,3)-move downward
+    CDT_STATS_MOVE_SCOPE(SHIFTD);
+    double edS = edsShift;
     double rg = 1.0;
     double ar = edS * rg;
-    int n3 = Universe::tetrasAll.size();
-    int vol_switch = Universe::volfix_switch;
+    int n3 = universe.tetrasAll.size();
 
-    if (vol_switch == 1 && targetVolume > 0) ar *= exp(epsilon * (2 * targetVolume - 2 * n3 - 1));
+    if (VS == 1 && targetVolume > 0) ar *= volfixExp(2 * targetVolume - 2 * n3 - 1);
 
     if (ar < 1.0) {
-        std::uniform_real_distribution<> uniform(0.0, 1.0);
-        if (uniform(rng) > ar) return false;
+        if (gen.uniform() > ar) { CDT_STATS_METRO_REJECT(SHIFTD); return false; }
     }
 
-    Tetra::Label tv = Universe::tetras31.pick();
     auto t = tv->tnbr[3];  // Vertical (1,3)-tetra
-    std::uniform_int_distribution<> neighborGen(1, 3);
-    Tetra::Label tn = t->tnbr[neighborGen(rng)];
+    Tetra::Label tn = t->tnbr[1 + gen.bounded(3)];
 
-    if (!tn->is22()) return false;
+    if (Tetra::typeOf(tn) != Tetra::TWOTWO) { CDT_STATS_GEOM_REJECT(SHIFTD); return false; }
 
-    return Universe::move23d(t, tn);
+    bool ok = CDT_STATS_RESULT(SHIFTD, universe.move23d(t, tn));
+    if (ok && traceActive) traceRecord(5, t, tn, -1);
+    return ok;
     // HPC Target [GPU #7]: Batch on GPU.
 }
 
-bool Simulation::moveShiftI() {  // Attempts (3,2)-move upward (Sec. 2.3.3)
-    double edS = exp(1 * k3);  // Action change (Sec. 2.3.3, eq. 29)
+template <int VS>
+bool Simulation::moveShiftI(Tetra::Label t, Xoshiro256pp &gen) {  // Attempts (3,2)-move upward (Sec. 2.3.3)
+    CDT_STATS_MOVE_SCOPE(ISHIFT);
+    double edS = edsIShift;  // Cached exp(k3) (Sec. 2.3.3, eq. 29)
     double rg = 1.0;
     double ar = edS * rg;
-    int n3 = Universe::tetrasAll.size();
-    int vol_switch = Universe::volfix_switch;
+    int n3 = universe.tetrasAll.size();
 
-    if (vol_switch == 1 && targetVolume > 0) ar *= exp(-epsilon * (2 * targetVolume - 2 * n3 - 1));
+    if (VS == 1 && targetVolume > 0) ar *= volfixExp(-(2 * targetVolume - 2 * n3 - 1));
 
     if (ar < 1.0) {
-        std::uniform_real_distribution<> uniform(0.0, 1.0);
-        if (uniform(rng) > ar) return false;
+        if (gen.uniform() > ar) { CDT_STATS_METRO_REJECT(ISHIFT); return false; }
     }
 
-    Tetra::Label t = Universe::tetras31.pick();
-    std::uniform_int_distribution<> neighborGen(0, 2);
-    int neighbor = neighborGen(rng);
+    int neighbor = gen.bounded(3);
     Tetra::Label t22l = t->tnbr[neighbor], t22r = t->tnbr[(neighbor + 2) % 3];
 
-    if (!t22l->is22() || !t22r->is22() || !t22l->neighborsTetra(t22r)) return false;
+    if (Tetra::typeOf(t22l) != Tetra::TWOTWO || Tetra::typeOf(t22r) != Tetra::TWOTWO || !t22l->neighborsTetra(t22r)) { CDT_STATS_GEOM_REJECT(ISHIFT); return false; }
 
     int sv = 0;  // Shared vertices
     for (int i = 0; i < 4; i++) if (t22r->hasVertex(t22l->vs[i])) sv++;
-    if (sv != 3) return false;  // Must share a face
+    if (sv != 3) { CDT_STATS_GEOM_REJECT(ISHIFT); return false; }  // Must share a face
 
-    return Universe::move32u(t, t22l, t22r);
+    bool ok = CDT_STATS_RESULT(ISHIFT, universe.move32u(t, t22l, t22r));
+    if (ok && traceActive) traceRecord(6, t, t22l, t22r);
+    return ok;
     // HPC Target [GPU #7]: Batch on GPU.
 }
 
-bool Simulation::moveShiftID() {  // Attempts (3,2)-move downward
-    double edS = exp(1 * k3);
+template <int VS>
+bool Simulation::moveShiftID(Tetra::Label t31, Xoshiro256pp &gen) {  // Attempts (3,2)-move downward
+    CDT_STATS_MOVE_SCOPE(ISHIFTD);
+    double edS = edsIShift;
     double rg = 1.0;
     double ar = edS * rg;
-    int n3 = Universe::tetrasAll.size();
-    int vol_switch = Universe::volfix_switch;
+    int n3 = universe.tetrasAll.size();
 
-    if (vol_switch == 1 && targetVolume > 0) ar *= exp(-epsilon * (2 * targetVolume - 2 * n3 - 1));
+    if (VS == 1 && targetVolume > 0) ar *= volfixExp(-(2 * targetVolume - 2 * n3 - 1));
 
     if (ar < 1.0) {
-        std::uniform_real_distribution<> uniform(0.0, 1.0);
-        if (uniform(rng) > ar) return false;
+        if (gen.uniform() > ar) { CDT_STATS_METRO_REJECT(ISHIFTD); return false; }
     }
 
-    Tetra::Label t = Universe::tetras31.pick()->tnbr[3];  // Vertical (1,3)-tetra
-    std::uniform_int_distribution<> neighborGen(0, 2);
-    int neighbor = neighborGen(rng);
+    Tetra::Label t = t31->tnbr[3];  // Vertical (1,3)-tetra
+    int neighbor = gen.bounded(3);
     Tetra::Label t22l = t->tnbr[1 + neighbor], t22r = t->tnbr[1 + (neighbor + 2) % 3];
 
-    if (!t22l->is22() || !t22r->is22() || !t22l->neighborsTetra(t22r)) return false;
+    if (Tetra::typeOf(t22l) != Tetra::TWOTWO || Tetra::typeOf(t22r) != Tetra::TWOTWO || !t22l->neighborsTetra(t22r)) { CDT_STATS_GEOM_REJECT(ISHIFTD); return false; }
 
     int sv = 0;
     for (int i = 0; i < 4; i++) if (t22r->hasVertex(t22l->vs[i])) sv++;
-    if (sv != 3) return false;
+    if (sv != 3) { CDT_STATS_GEOM_REJECT(ISHIFTD); return false; }
 
-    return Universe::move32d(t, t22l, t22r);
+    bool ok = CDT_STATS_RESULT(ISHIFTD, universe.move32d(t, t22l, t22r));
+    if (ok && traceActive) traceRecord(7, t, t22l, t22r);
+    return ok;
     // HPC Target [GPU #7]: Batch on GPU.
 }
 
+void Simulation::writeCheckpoint(std::string outFile, int phase, int sweep) {  // Full simulation state (Sec. 3.3)
+    measureJoin();  // Observable buffers and rng states must include the sweep's measurements
+    CDT_STATS_PHASE_SCOPE(CHECKPOINT);
+    universe.finishExports();  // The geometry snapshot below must not race a background write
+    universe.canonicalizeState();  // Continue from the same hint state a resumed run rebuilds
+    if (traceActive) traceRecord(9, -1, -1, -1);  // Hints steer later moves' walks; replay must match
+    universe.exportGeometry(checkpointGeometryFile(outFile));  // Synchronous, canonical order
+
+    std::string tmpName = checkpointFile(outFile) + ".tmp";  // Publish atomically via rename
+    std::ofstream file(tmpName, std::ios::out | std::ios::trunc | std::ios::binary);
+    assert(file.is_open());
+
+    file.write(reinterpret_cast<const char *>(&checkpointMagic), sizeof(checkpointMagic));
+    int32_t rec[2] = {static_cast<int32_t>(phase), static_cast<int32_t>(sweep)};
+    file.write(reinterpret_cast<const char *>(rec), sizeof(rec));
+    file.write(reinterpret_cast<const char *>(&k0), sizeof(k0));
+    file.write(reinterpret_cast<const char *>(&k3), sizeof(k3));  // The tuned value (Sec. 3.3.1)
+
+    double tuneD[5] = {tuneWinK3, tuneWinN, tunePrevK3, tunePrevN, tuneSlope};
+    file.write(reinterpret_cast<const char *>(tuneD), sizeof(tuneD));
+    int32_t tuneI[5] = {tuneWinCount, tunePrevValid, tuneSlopeValid, tuneStableSweeps, thermalDone};
+    file.write(reinterpret_cast<const char *>(tuneI), sizeof(tuneI));
+    // Comment: Autotuner history (Sec. 3.3.1); written even with autotune off (all
+    // zeros then) so the record layout does not depend on the config.
+
+    rng.save(file);  // Move-selection stream
+    int32_t nt = threadRngs.size();
+    file.write(reinterpret_cast<const char *>(&nt), sizeof(nt));
+    for (auto &g : threadRngs) g.save(file);  // Sweep-thread streams
+
+    universe.saveCheckpointState(file);  // Bag rng and candidate-Bag element order
+
+    int32_t n3d = observables3d.size(), n2d = observables2d.size();
+    file.write(reinterpret_cast<const char *>(&n3d), sizeof(n3d));
+    for (auto o : observables3d) o->saveState(file);
+    file.write(reinterpret_cast<const char *>(&n2d), sizeof(n2d));
+    for (auto o : observables2d) o->saveState(file);
+
+    file.close();
+    std::rename(tmpName.c_str(), checkpointFile(outFile).c_str());  // A crash mid-write keeps the old checkpoint
+}
+
+bool Simulation::readCheckpoint(std::string outFile, int &phase, int &sweep) {  // Inverse of writeCheckpoint()
+    std::ifstream file(checkpointFile(outFile), std::ios::in | std::ios::binary);
+    if (!file.is_open()) return false;  // No checkpoint yet: fresh run
+
+    int32_t magic;
+    file.read(reinterpret_cast<char *>(&magic), sizeof(magic));
+    if (magic != checkpointMagic) {
+        printf("checkpoint %s has wrong magic, starting fresh\n", checkpointFile(outFile).c_str());
+        return false;
+    }
+
+    int32_t rec[2];
+    file.read(reinterpret_cast<char *>(rec), sizeof(rec));
+    phase = rec[0];
+    sweep = rec[1];
+    file.read(reinterpret_cast<char *>(&k0), sizeof(k0));
+    file.read(reinterpret_cast<char *>(&k3), sizeof(k3));
+    updateActionConstants();  // The cached factors must match the restored couplings
+
+    double tuneD[5];
+    file.read(reinterpret_cast<char *>(tuneD), sizeof(tuneD));
+    tuneWinK3 = tuneD[0]; tuneWinN = tuneD[1];
+    tunePrevK3 = tuneD[2]; tunePrevN = tuneD[3];
+    tuneSlope = tuneD[4];
+    int32_t tuneI[5];
+    file.read(reinterpret_cast<char *>(tuneI), sizeof(tuneI));
+    tuneWinCount = tuneI[0];
+    tunePrevValid = tuneI[1];
+    tuneSlopeValid = tuneI[2];
+    tuneStableSweeps = tuneI[3];
+    thermalDone = tuneI[4];
+    // Comment: The controller resumes mid-trajectory; the next tune() continues the
+    // same window and slope estimate the interrupted run would have used.
+
+    rng.load(file);
+    int32_t nt;
+    file.read(reinterpret_cast<char *>(&nt), sizeof(nt));
+    if (nt != static_cast<int32_t>(threadRngs.size())) {
+        printf("checkpoint was written with %d sweep threads, this run has %d; starting fresh\n",
+               nt, static_cast<int>(threadRngs.size()));
+        return false;  // Bit-exact continuation needs the same thread decomposition
+    }
+    for (auto &g : threadRngs) g.load(file);
+
+    universe.restoreCheckpointState(file);
+
+    int32_t n3d, n2d;
+    file.read(reinterpret_cast<char *>(&n3d), sizeof(n3d));
+    assert(n3d == static_cast<int32_t>(observables3d.size()));
+    for (auto o : observables3d) o->loadState(file);
+    file.read(reinterpret_cast<char *>(&n2d), sizeof(n2d));
+    assert(n2d == static_cast<int32_t>(observables2d.size()));
+    for (auto o : observables2d) o->loadState(file);
+
+    return true;
+}
+
+void Simulation::traceOpen() {  // Arms accepted-move recording for this run
+    if (resume) {
+        printf("tracefile: tracing disabled on resume (the trace would miss the completed sweeps)\n");
+        return;
+    }
+    if (nThreads > 1) {
+        printf("tracefile: tracing requires serial sweeps (threads 1), disabled\n");
+        return;  // Label allocation order depends on the thread interleaving
+    }
+    traceStream.open(traceFile, std::ios::out | std::ios::trunc | std::ios::binary);
+    assert(traceStream.is_open());
+    traceStream.write(reinterpret_cast<const char *>(&traceMagic), sizeof(traceMagic));
+    tracePending.reserve(1 << 16);
+    traceActive = true;
+}
+
+void Simulation::traceRecord(int type, int a0, int a1, int a2) {  // One accepted move or marker
+    tracePending.push_back(static_cast<char>(type));
+    int32_t args[3] = {a0, a1, a2};
+    tracePending.append(reinterpret_cast<const char *>(args), traceArgc[type] * sizeof(int32_t));
+    if (tracePending.size() >= (1 << 16)) {  // Block writes, like the observable output
+        traceStream.write(tracePending.data(), tracePending.size());
+        tracePending.clear();
+    }
+}
+
+void Simulation::traceClose() {  // Final flush at the end of start()
+    if (!traceActive) return;
+    traceStream.write(tracePending.data(), tracePending.size());
+    tracePending.clear();
+    traceStream.close();
+    traceActive = false;
+    printf("trace written to %s\n", traceFile.c_str());
+}
+
+void Simulation::replay(std::string traceName) {  // Re-applies a recorded move trace
+    std::ifstream file(traceName, std::ios::in | std::ios::binary);
+    if (!file.is_open()) {
+        printf("replay: cannot open %s\n", traceName.c_str());
+        return;
+    }
+    int32_t magic;
+    file.read(reinterpret_cast<char *>(&magic), sizeof(magic));
+    if (magic != traceMagic) {
+        printf("replay: %s is not a move trace\n", traceName.c_str());
+        return;
+    }
+
+    for (auto o : observables3d) o->clear();
+    for (auto o : observables2d) o->clear();
+
+    auto t0 = std::chrono::steady_clock::now();
+    long applied = 0;
+    char type;
+    while (file.read(&type, 1)) {
+        int32_t a[3] = {-1, -1, -1};
+        file.read(reinterpret_cast<char *>(a), traceArgc[static_cast<int>(type)] * sizeof(int32_t));
+        bool ok = true;
+        switch (type) {
+            case 1: ok = universe.move26(a[0]); break;
+            case 2: ok = universe.move62<0>(a[0]); break;
+            case 3: ok = universe.move44<0>(a[0], a[1]); break;
+            case 4: ok = universe.move23u(a[0], a[1]); break;
+            case 5: ok = universe.move23d(a[0], a[1]); break;
+            case 6: ok = universe.move32u(a[0], a[1], a[2]); break;
+            case 7: ok = universe.move32d(a[0], a[1], a[2]); break;
+            case 8: universe.compactGeometry(); break;
+            case 9: universe.canonicalizeState(); break;
+            default:
+                printf("replay: unknown record type %d after %ld records\n", type, applied);
+                return;
+        }
+        assert(ok);  // A recorded move cannot fail on the recorded state
+        applied++;
+    }
+    // Comment: Strictness-0 instantiations: the recording run already passed the
+    // manifold checks, so replay only re-executes the accepted rewrites. Vertex
+    // and tetra labels come out bit-identical to the recording run (Pool
+    // allocation is deterministic); the half-edge and triangle layers are
+    // derived and rebuilt fresh by prepare() below.
+    double applySec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    printf("replay: %ld records in %.3f s (%.3g records/s)\n", applied, applySec, applied / applySec);
+
+    t0 = std::chrono::steady_clock::now();
+    prepare();  // Rebuild the derived connectivity once, on the final geometry
+    printf("replay: updateGeometry() %.3f s\n", std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count());
+
+    t0 = std::chrono::steady_clock::now();
+    for (auto o : observables3d) o->measure();
+    for (auto o : observables2d) o->measure();
+    printf("replay: %d observables %.3f s\n", static_cast<int>(observables3d.size() + observables2d.size()),
+           std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count());
+    printf("t31: %d\n", static_cast<int>(universe.tetras31.size()));
+}
+
 void Simulation::prepare() {  // Prepares for measurements (Sec. 3.3.3)
-    Universe::updateGeometry();  // Updates connectivity (Sec. 3.2)
+    measureJoin();  // A pipelined stage still reads the previous snapshot
+    CDT_STATS_PHASE_SCOPE(PREPARE);
+    universe.updateGeometry();  // Updates connectivity (Sec. 3.2)
     // HPC Target [OpenMP #3]: Parallelize if BFS involved.
 }
 
+void Simulation::measureAll(std::vector<Observable*> &obs) {  // Measurement stage dispatch
+    if (!pipeline && obs.size() <= 1) {  // Nothing to overlap; skip the pool hand-off
+        for (auto o : obs) o->measure();
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(measureMutex);
+    while (measureWorkers.size() < obs.size())  // Lazy, grows to the widest stage
+        measureWorkers.emplace_back(&Simulation::measureWorker, this);
+
+    measureQueue = obs;  // Publish the stage
+    measureNext = 0;
+    measureOutstanding = static_cast<int>(obs.size());
+    measureCv.notify_all();
+
+    if (pipeline) {
+        bool stageSafe = true;  // Overlap only observables audited for it (observable.hpp)
+        for (auto o : obs) if (!o->pipelineSafe) stageSafe = false;
+        if (stageSafe) return;  // Pipelined: the stage overlaps the next sweep; it is
+                                // joined by measureJoin() before its snapshot goes stale
+        if (!warnedPipelineUnsafe) {
+            printf("measureAll: stage has a non-pipeline-safe observable; measuring before the sweep\n");
+            fflush(stdout);
+            warnedPipelineUnsafe = true;
+        }
+        // Comment: Moves destroy half-edges and triangles mid-sweep, so an
+        // observable that walks them must finish before the sweep starts; the
+        // whole stage waits, since a partial overlap would reorder measurements.
+    }
+
+    measureDoneCv.wait(lock, [this] { return measureOutstanding == 0; });
+    measureQueue.clear();  // Leaves the wait predicate false for idle workers
+    measureNext = 0;
+    // Comment: The geometry is frozen between prepare() and the next sweep, and each
+    // observable owns its rng, output buffer and data file, so the pooled measure()
+    // calls are independent; results are bit-identical to the serial loop.
+}
+
+void Simulation::measureJoin() {  // Waits out an in-flight pipelined stage
+    std::unique_lock<std::mutex> lock(measureMutex);
+    if (measureQueue.empty() && measureOutstanding == 0) return;  // Nothing in flight
+    measureDoneCv.wait(lock, [this] { return measureOutstanding == 0; });
+    measureQueue.clear();
+    measureNext = 0;
+    // Comment: Called before the stage's inputs go stale (prepare(), checkpoints,
+    // compactGeometry()) and before the run tears the engine down.
+}
+
+void Simulation::measureWorker() {  // Pool worker: one measure() call per claim
+    std::unique_lock<std::mutex> lock(measureMutex);
+    while (true) {
+        measureCv.wait(lock, [this] {
+            return measureShutdown || measureNext < measureQueue.size();
+        });
+        if (measureShutdown) return;
+        Observable *o = measureQueue[measureNext++];
+        lock.unlock();
+        o->measure();  // Off the lock; the heavy BFS work happens here
+        lock.lock();
+        if (--measureOutstanding == 0) measureDoneCv.notify_one();
+    }
+    // Comment: Workers live for the Simulation's lifetime so their thread_local BFS
+    // Markers (sized to the Pool capacities) are allocated once, not per stage.
+}
+
+Simulation::~Simulation() {  // Stops the persistent measurement pool
+    measureJoin();  // Never abandon an in-flight pipelined stage
+    {
+        std::unique_lock<std::mutex> lock(measureMutex);
+        measureShutdown = true;
+    }
+    measureCv.notify_all();
+    for (auto &w : measureWorkers) w.join();
+}
+
 void Simulation::tune() {  // Tunes k3 to pseudocritical value (Sec. 3.3.1)
     double delta_k3 = 0.000001;  // Step size
     double ratio = 100;          // Scaling factor (unused in code?)
@@ -369,10 +984,70 @@ void Simulation::tune() {  // Tunes k3 to pseudocritical value (Sec. 3.3.1)
     int border_vclose = targetVolume * 0.002; // Very close threshold
     int border_vvclose = targetVolume * 0.0001; // Extremely close threshold
 
-    int vol_switch = Universe::volfix_switch;
-    int fixvolume = vol_switch == 0 ? Universe::tetras31.size() : Universe::tetrasAll.size();
+    int vol_switch = universe.volfix_switch;
+    int fixvolume = vol_switch == 0 ? universe.tetras31.size() : universe.tetrasAll.size();
 
     int diff = targetVolume - fixvolume;  // Volume deviation
+
+    if (autotune) {  // Secant controller: fit the response, step directly (Sec. 3.3.1)
+        tuneWinK3 += k3;  // Accumulate the current window
+        tuneWinN += fixvolume;
+        tuneWinCount++;
+        const int window = 5;  // Sweeps per response-fit window
+        if (tuneWinCount == window) {
+            double k3mean = tuneWinK3 / window;
+            double nmean = tuneWinN / window;
+            if (tunePrevValid && fabs(k3mean - tunePrevK3) > 10 * delta_k3) {
+                double slope = (nmean - tunePrevN) / (k3mean - tunePrevK3);
+                if (slope < 0) {  // Physical branch: larger k3 suppresses volume
+                    tuneSlope = tuneSlopeValid ? 0.5 * tuneSlope + 0.5 * slope : slope;
+                    tuneSlopeValid = true;
+                }
+                // Comment: A positive secant means noise dominated the window
+                // (too small a k3 excursion); keep the previous estimate.
+            }
+            tunePrevK3 = k3mean;
+            tunePrevN = nmean;
+            tunePrevValid = true;
+            tuneWinK3 = tuneWinN = 0;
+            tuneWinCount = 0;
+        }
+
+        if (tuneSlopeValid) {
+            double step = diff / tuneSlope;  // Newton step toward targetVolume
+            double cap = delta_k3 * 10000;   // At most 10x the ladder's largest step
+            if (step > cap) step = cap;
+            if (step < -cap) step = -cap;
+            k3 += step;
+            // Comment: diff > 0 needs more volume, so with a negative slope the
+            // step lowers k3; the cap keeps one noisy fit from derailing the run.
+        } else {  // Bootstrap on the ladder until two windows bracket a secant
+            if (diff > border_close) k3 -= delta_k3 * 1000;
+            else if (diff < -border_close) k3 += delta_k3 * 1000;
+            else if (diff > border_vclose) k3 -= delta_k3 * 100;
+            else if (diff < -border_vclose) k3 += delta_k3 * 100;
+            else if (diff > border_vvclose) k3 -= delta_k3 * 20;
+            else if (diff < -border_vvclose) k3 += delta_k3 * 20;
+        }
+
+        // Equilibrium test: the windowed mean volume on target, and the add/delete
+        // drift of the last sweep consistent with a stationary random walk. The
+        // window mean is used rather than the instantaneous count because the
+        // volume-fixing term lets N fluctuate with sigma ~ 1/sqrt(2 epsilon) (~110
+        // at the default epsilon), far wider than the tightest ladder band. Both
+        // must hold for several consecutive sweeps before thermalization may end.
+        bool nearTarget = tunePrevValid && fabs(tunePrevN - targetVolume) < border_close;
+        bool driftFree = abs(lastSweepNetGrow) < (border_close > 10 ? border_close : 10);
+        if (nearTarget && driftFree && tuneSlopeValid) {
+            if (++tuneStableSweeps >= 10) thermalDone = true;
+        } else {
+            tuneStableSweeps = 0;
+        }
+
+        updateActionConstants();  // k3 moved; refresh the cached acceptance factors
+        return;
+    }
+
     if (diff > border_far) k3 -= delta_k3 * 1000;         // Large decrease
     else if (diff < -border_far) k3 += delta_k3 * 1000;   // Large increase
     else if (diff > border_close) k3 -= delta_k3 * 1000;  // Moderate decrease
@@ -382,4 +1057,26 @@ void Simulation::tune() {  // Tunes k3 to pseudocritical value (Sec. 3.3.1)
     else if (diff > border_vvclose) k3 -= delta_k3 * 20;  // Tiny decrease
     else if (diff < -border_vvclose) k3 += delta_k3 * 20; // Tiny increase
     // Comment: Adaptive tuning based on volume deviation (Sec. 3.3.1).
+
+    updateActionConstants();  // k3 moved; refresh the cached acceptance factors
+}
+
+void Simulation::updateActionConstants() {  // Caches the constant parts of the acceptance ratios (Sec. 2.3)
+    edsAdd = exp(1 * k0 - 4 * k3);     // (2,6)-move (eq. 25)
+    edsDelete = exp(-1 * k0 + 4 * k3); // (6,2)-move (eq. 27)
+    edsShift = exp(-1.0 * k3);         // (2,3)-moves (eq. 28)
+    edsIShift = exp(1 * k3);           // (3,2)-moves (eq. 29)
+
+    if (volfixTable.empty()) {  // Depends only on epsilon; built once
+        volfixTable.resize(2 * volfixRange + 1);
+        for (int m = -volfixRange; m <= volfixRange; m++)
+            volfixTable[m + volfixRange] = exp(epsilon * m);
+    }
+    // Comment: Recomputed once per tune() instead of once per attempt; with
+    // ksteps*1000 attempts per sweep this removes the exp() from the hot path.
+}
+
+double Simulation::volfixExp(int m) {  // Volume-fixing factor exp(epsilon * m) (Sec. 2.4)
+    if (m < -volfixRange || m > volfixRange) return exp(epsilon * m);  // Far from target (early thermalization)
+    return volfixTable[m + volfixRange];  // Hot path: one load
 }
\ No newline at end of file
@@ -2,21 +2,33 @@
 #pragma once  // Prevents multiple inclusions
 // Comment: Standard header guard.
 
-#include <random>       // For std::default_random_engine
 #include <vector>       // For std::vector (observables, sweep results)
 #include <string>       // For std::string (outFile)
+#include <fstream>      // For the move-trace stream
+#include <thread>       // For the persistent measurement pool workers
+#include <mutex>        // For the measurement pool queue
+#include <condition_variable>  // For the measurement pool hand-off
 #include "universe.hpp" // Universe class for triangulation management
 
 // Comment: Forward declaration of Observable class (defined elsewhere, e.g., observable.hpp).
 class Observable;
 
 // Comment: Simulation manages the Monte Carlo simulation process for 3D CDT (Sec. 2, 3.3).
+// One instance drives one replica's Universe; instances share only the Pool arena.
 class Simulation {
 public:
-    static double lambda;  // Cosmological coupling constant (Sec. 2.3)
+    explicit Simulation(Universe &universe_) : universe(universe_) {}
+    // Comment: Binds the engine to its replica's triangulation (Sec. 3).
+
+    ~Simulation();  // Stops the persistent measurement pool (simulation.cpp)
+
+    Universe &universe;  // The replica's triangulation state
+    // Comment: All move wrappers and sweeps act on this instance.
+
+    double lambda;  // Cosmological coupling constant (Sec. 2.3)
     // Comment: Likely a legacy or misnamed variable; paper uses k3 for cosmological coupling.
 
-    static void start(double k0, double k3, int sweeps, int thermalSweeps, int ksteps, int targetVolume_, int target2Volume, int seed, std::string outFile, int v1, int v2, int v3);
+    void start(double k0, double k3, int sweeps, int thermalSweeps, int ksteps, int targetVolume_, int target2Volume, int seed, std::string outFile, int v1, int v2, int v3);
     // Comment: Initiates the simulation with parameters (Sec. 3.3):
     // - k0: Gravitational coupling (1/G_N, Sec. 2.3)
     // - k3: Cosmological coupling (Sec. 2.3)
@@ -29,77 +41,287 @@ public:
     // - v1, v2, v3: Custom parameters (possibly move weights or debug flags)
     // HPC Targets: [OpenMP #1], [MPI #4], [GPU #7], [General #12]
 
-    static void addObservable3d(Observable& o) {
+    void addObservable3d(Observable& o) {
         observables3d.push_back(&o);  // Adds a 3D observable
     }
     // Comment: Registers a 3D observable (e.g., VolumeProfile, Sec. 3.4).
 
-    static void addObservable2d(Observable& o) {
+    void addObservable2d(Observable& o) {
         observables2d.push_back(&o);  // Adds a 2D observable
     }
     // Comment: Registers a 2D observable (e.g., Ricci2d, Sec. 3.4); unexpected in 3D context (see main.cpp note).
 
-    static std::array<int, 3> moveFreqs;  // Frequencies of move attempts
+    std::array<int, 3> moveFreqs = {0, 0, 0};  // Frequencies of move attempts
     // Comment: Likely tracks add/delete, flip, shift move counts (Sec. 2.3).
 
-    static int attemptMove();  // Attempts a random Monte Carlo move
+    bool resume = false;  // Continue from a checkpoint written by a previous run
+    // Comment: Set from the optional "resume" config key in main.cpp. start() then
+    // restores couplings, rng states and the sweep index from <outfile>.ckpt (the
+    // geometry itself is reloaded from <outfile>.ckpt.bcdt by main.cpp) and skips
+    // the completed sweeps; absent or mismatched checkpoints fall back to a fresh run.
+
+    static std::string checkpointFile(std::string outFile) { return outFile + ".ckpt"; }
+    static std::string checkpointGeometryFile(std::string outFile) { return outFile + ".ckpt.bcdt"; }
+    // Comment: Naming shared with main.cpp, which picks the initialize() input file.
+
+    bool pipeline = false;  // Overlap measurement with the next sweep (1 = pipelined)
+    // Comment: Set from the optional "pipeline" config key in main.cpp. measureAll()
+    // then returns right after handing the stage to the pool, and performSweep()
+    // resumes on the live geometry; the stage is joined before anything that
+    // invalidates its snapshot (the next prepare(), compactGeometry(), checkpoints).
+    // The overlap is only sound for observables that read the frozen snapshot and
+    // vertexCsr exclusively: moves DO destroy derived structures mid-sweep — every
+    // add/delete/flip retireSpatialData()s its base triangle, Pool-destroying the
+    // triangle and its half-edges, and the half-edge free-list link lands in the
+    // next field traversals follow. measureAll() therefore overlaps a stage only
+    // when every observable in it sets pipelineSafe (observable.hpp); otherwise it
+    // prints a notice once and measures before the sweep. Overlapped results are
+    // bit-identical to the serial stage.
+
+    bool autotune = false;  // Secant k3 controller + early thermalization exit (1 = on)
+    // Comment: Set from the optional "autotune" config key in main.cpp. tune() then
+    // fits the local volume response d<N>/dk3 from windowed (k3, N) history and
+    // steps k3 directly toward the pseudocritical value instead of climbing the
+    // fixed ladder, and the thermal loop in start() ends early once the volume,
+    // the controller and the add/delete balance have all been stationary for
+    // several consecutive sweeps (thermalSweeps stays the upper bound). Off by
+    // default: the historical ladder and the full sweep count are unchanged.
+
+    std::string traceFile = "";  // Record accepted moves to this file ("" = off)
+    // Comment: Set from the optional "tracefile" config key in main.cpp. Each
+    // accepted move is logged as a compact binary record (type byte + the Label
+    // arguments passed to the Universe::move*() call), so replay() can rebuild the
+    // exact geometry without rng, acceptance tests or rejected proposals. Pool
+    // allocation is deterministic given the same starting geometry, so the
+    // recorded labels stay valid on replay. Requires a fresh serial run: with
+    // nThreads > 1 the label allocation order depends on thread interleaving, and
+    // a resumed run would only trace the remaining sweeps; both disable tracing
+    // with a notice.
+
+    void replay(std::string traceName);  // Re-applies a recorded trace (no Monte Carlo)
+    // Comment: Streams the trace through the Universe::move*() functions (manifold
+    // checks skipped: the recording run already validated every move), then runs
+    // updateGeometry() and one measurement pass over the registered observables,
+    // printing wall-clock timings for each stage. Used to benchmark the geometry
+    // and observable kernels on bit-identical states across code revisions; see
+    // the "replayfile" config key in main.cpp.
+
+    int nThreads = 1;  // Sweep threads for the slab-parallel engine (1 = serial)
+    // Comment: Set from the optional "threads" config key in main.cpp. performSweep()
+    // decomposes the S^1 direction into 2*nThreads slab blocks and runs the two
+    // interleaved colors in alternating phases, so concurrently active blocks never
+    // share a slice (Sec. 2.3 move locality).
+
+    int proposalBatch = 0;  // Proposals generated per batch in serial sweeps (0/1 = off)
+    // Comment: Set from the optional "proposalbatch" config key in main.cpp. When
+    // > 1, performSweep() draws that many (move type, seed pick, direction) tuples
+    // up front against the current Bag state, prefetches the picked seeds' pool
+    // slots, then runs validation and acceptance serially over the warmed batch.
+    // Proposal setup is latency-bound (dependent Bag and pool loads per attempt);
+    // batching overlaps those loads. Seeds killed by an earlier move in the same
+    // batch are re-validated against the Bags and skipped, like the stale snapshot
+    // picks of the slab-parallel engine. The hoisted picks change the rng draw
+    // order, so trajectories differ from the serial default — off by default.
+
+    int attemptMove() { return (this->*attemptMoveKernel)(rng, nullptr); }  // Attempts a random Monte Carlo move
     // Comment: Selects and tries a move (Sec. 2.3); returns move type or success indicator.
+    // Dispatches to the kernel instantiation bound by bindMoveKernels() for this
+    // run's (volfix_switch, strictness) pair, so the hot path carries no dead branches.
     // HPC Target: [GPU #7]
 
-    static int targetVolume;   // Target total volume (Sec. 2.4)
-    static int target2Volume;  // Secondary target volume (possibly for tuning)
+    int targetVolume = 0;   // Target total volume (Sec. 2.4)
+    int target2Volume = 0;  // Secondary target volume (possibly for tuning)
 
-    static int thermal;  // Thermalization status or counter
+    int thermal;  // Thermalization status or counter
     // Comment: Tracks thermalization phase (Sec. 3.3.2).
 
-    static double k3_s;  // Stored k3 value (starting or tuned?)
-    static double k0;    // Gravitational coupling (Sec. 2.3)
-    static double k3;    // Cosmological coupling (Sec. 2.3)
+    double k3_s;  // Stored k3 value (starting or tuned?)
+    double k0 = 0;    // Gravitational coupling (Sec. 2.3)
+    double k3 = 0;    // Cosmological coupling (Sec. 2.3)
     // Comment: Simulation parameters set by start().
 
 private:
-    static std::default_random_engine rng;  // RNG for move selection
-    // Comment: Randomness source (Sec. 2.1).
+    Xoshiro256pp rng{0};  // RNG for move selection
+    // Comment: Per-replica randomness source, reseeded from the run seed in start() (Sec. 2.1).
     // HPC Target: [MPI #4]
 
-    static double epsilon;  // Volume fixing strength (Sec. 2.4)
+    double epsilon = 0.00004;  // Volume fixing strength (Sec. 2.4)
     // Comment: Controls fluctuation size in S_fix = ε(N - N̄)^2.
 
-    static bool measuring;  // Flag for measurement phase
+    // Precomputed acceptance factors (Sec. 2.3.1-2.3.3); k0 and k3 are constant
+    // between tune() calls, so the exp() of the bare action change is cached here
+    // instead of being recomputed tens of millions of times per sweep.
+    double edsAdd = 1.0;     // exp(k0 - 4 k3), (2,6)-move (eq. 25)
+    double edsDelete = 1.0;  // exp(-k0 + 4 k3), (6,2)-move (eq. 27)
+    double edsShift = 1.0;   // exp(-k3), (2,3)-moves (eq. 28)
+    double edsIShift = 1.0;  // exp(k3), (3,2)-moves (eq. 29)
+
+    static const int volfixRange = 32768;  // Table half-width in units of epsilon
+    std::vector<double> volfixTable;  // exp(epsilon * m) for m in [-volfixRange, volfixRange]
+    double volfixExp(int m);  // Volume-fixing factor exp(epsilon * m); exp() fallback outside the table
+    // Comment: Every volfix exponent in the move wrappers is epsilon times an
+    // integer, so one shared table serves all six moves and both volfix modes.
+
+    void updateActionConstants();  // Refreshes eds* (and the table on first call) after k0/k3 change
+    // Comment: Called from start() and tune(); the table depends only on epsilon.
+
+    bool measuring = false;  // Flag for measurement phase
     // Comment: Distinguishes thermalization vs. measurement (Sec. 3.3).
 
-    static std::vector<Observable*> observables3d;  // 3D observables list
-    static std::vector<Observable*> observables2d;  // 2D observables list
+    std::vector<Observable*> observables3d;  // 3D observables list
+    std::vector<Observable*> observables2d;  // 2D observables list
     // Comment: Stores pointers to observables (Sec. 3.4).
     // HPC Target: [OpenMP #2]
 
-    static std::vector<int> performSweep(int n);  // Executes n move attempts
+    void measureAll(std::vector<Observable*> &obs);  // Measurement stage dispatch
+    void measureJoin();                              // Waits out an in-flight stage
+    void measureWorker();                            // Pool worker loop
+    // Comment: With more than one registered observable the stage fans out over a
+    // persistent thread pool: the geometry is frozen after prepare(), and each
+    // observable owns its rng, output buffer and file while the BFS scratch Markers
+    // are thread_local, so concurrent measure() calls share no mutable state. The
+    // workers persist across measurements to keep their (pool-capacity-sized)
+    // thread_local Markers warm instead of reallocating them every stage.
+    std::vector<std::thread> measureWorkers;  // Spawned lazily on first multi-observable stage
+    std::vector<Observable*> measureQueue;    // Work list for the stage in flight
+    size_t measureNext = 0;                   // Next unclaimed queue slot
+    int measureOutstanding = 0;               // Observables not yet finished
+    bool measureShutdown = false;             // Set by the destructor
+    std::mutex measureMutex;                  // Guards the queue state above
+    std::condition_variable measureCv;        // Workers wait here for work
+    std::condition_variable measureDoneCv;    // The sweep thread waits here for the stage
+
+    std::vector<int> performSweep(int n);  // Executes n move attempts
     // Comment: Performs a sweep (Sec. 3.3.2, 3.3.3); returns move stats.
-    // HPC Target: [OpenMP #1]
-
-    // Move attempt methods (Sec. 2.3)
-    static bool moveAdd();     // (2,6)-move (Sec. 2.3.1)
-    static bool moveDelete();  // (6,2)-move (Sec. 2.3.1)
-    static bool moveFlip();    // (4,4)-move (Sec. 2.3.2)
-    static bool moveShift();   // (2,3)-move upward (Sec. 2.3.3)
-    static bool moveShiftD();  // (2,3)-move downward
-    static bool moveShiftI();  // (3,2)-move upward (ishift)
-    static bool moveShiftID(); // (3,2)-move downward (ishift)
+    // Runs the slab-parallel engine when nThreads > 1 and the S^1 direction is long
+    // enough for the coloring; falls back to the serial loop otherwise.
+
+    struct MoveCandidates {  // Seed simplices one sweep thread may propose from
+        std::vector<Tetra::Label> tetras31;   // (3,1)-tetras with base slab in the seed range
+        std::vector<Vertex::Label> vertices;  // Delete candidates (verticesSix) with time in the seed range
+        int slabLo;  // Inclusive seed range on S^1 (may wrap); one-slab buffer at each
+        int slabHi;  // block edge keeps all writes of a move inside the owning block
+    };
+    // Comment: Snapshots taken at the start of each color phase; a thread's own moves
+    // can invalidate entries, so picks are re-validated against the Bags and against
+    // the seed range: with pool reclamation deferred to the phase barrier, a stale
+    // entry is either the object it named at phase start or a dead slot no Bag
+    // contains, so the two checks together keep every accepted seed in-block.
+
+    static bool seedInBlock(const MoveCandidates *cand, int time) {  // Wrap-aware range test
+        if (cand->slabLo <= cand->slabHi) return time >= cand->slabLo && time <= cand->slabHi;
+        return time >= cand->slabLo || time <= cand->slabHi;  // Seed range wraps the S^1
+    }
+
+    struct Proposal {  // One pre-drawn move attempt of the batched pipeline
+        int move;  // Move family: 1 add, 2 delete, 3 flip, 4 shift, 5 ishift
+        int sub;   // Direction for shift/ishift: 0 up, 1 down
+        int seed;  // Picked seed label (Tetra for 1/3/4/5, Vertex for 2; -1 = none)
+    };
+    std::vector<Proposal> proposalBuf;  // Reused across batches; capacity is retained
+    template <int VS, int S>
+    void attemptMoveBatch(Xoshiro256pp &gen, int count, std::vector<int> &moves, std::vector<int> &failed_moves);
+    void (Simulation::*attemptMoveBatchKernel)(Xoshiro256pp &, int, std::vector<int> &, std::vector<int> &) = nullptr;
+    // Comment: Generation pass fills proposalBuf with the same per-attempt draw
+    // sequence attemptMove() uses (type, coins, Bag pick) and prefetches each seed's
+    // pool slot; the execution pass then re-validates liveness and runs the move
+    // wrappers over the warmed batch. Bound alongside attemptMoveKernel.
+
+    void sweepAttemptsParallel(int n, std::vector<int> &moves, std::vector<int> &failed_moves);
+    int partitionOffset = 0;  // Rotates the slab partition so block boundaries migrate every sweep
+    bool warnedSerialFallback = false;  // The threads-requested-but-serial notice prints once per run
+    bool warnedPipelineUnsafe = false;  // The stage-measured-synchronously notice prints once per run
+    // Comment: Slab-decomposed attempt loop: two colors of 2*nThreads blocks, run in
+    // alternating phases with the partition offset rotated every sweep so every slab
+    // is proposable again after two phases (preserves ergodicity/detailed balance).
+
+    template <int VS, int S> int attemptMove(Xoshiro256pp &gen, const MoveCandidates *cand);
+    // Comment: Draws move type and seed; cand == nullptr means pick from the global Bags.
+    // VS/S are compile-time copies of volfix_switch and strictness: both are fixed
+    // for the lifetime of a run, yet were branched on inside every move attempt.
+
+    int attemptVolfixMove(int direction, bool sliceMode) { return (this->*volfixMoveKernel)(direction, sliceMode); }
+    template <int VS, int S> int attemptVolfixMove(int direction, bool sliceMode);
+    // Comment: Biased proposal for the volume-targeting loops in start() (Sec. 2.4):
+    // only volume-changing move types are drawn, in the direction of the target.
+    // sliceMode restricts to add/delete (the only moves that change sliceSizes).
+
+    int (Simulation::*attemptMoveKernel)(Xoshiro256pp &, const MoveCandidates *) = nullptr;
+    int (Simulation::*volfixMoveKernel)(int, bool) = nullptr;
+    void bindMoveKernels();  // Selects the (VS, S) instantiations once, at start()
+    template <int VS, int S> void bindMoveKernels();
+    // Comment: One indirect call per attempt replaces the per-attempt config branches;
+    // inside the bound kernel the compiler folds the volume-fixing and strictness terms.
+
+    Tetra::Label pickSeedTetra(Xoshiro256pp &gen, const MoveCandidates *cand);
+    Vertex::Label pickSeedVertex(Xoshiro256pp &gen, const MoveCandidates *cand);
+    // Comment: Seed selection helpers; return -1 when a stale snapshot entry is drawn.
+
+    std::vector<Xoshiro256pp> threadRngs;  // One engine per sweep thread
+    // Comment: Seeded from the run seed in start(); keeps per-thread streams independent.
+
+    // Move attempt methods (Sec. 2.3); seed simplex picked by the caller.
+    // Templated on the run-constant config (VS = volfix_switch, S = strictness) so
+    // the volume-fixing branch and the manifold checks specialize at compile time.
+    template <int VS> bool moveAdd(Tetra::Label t, Xoshiro256pp &gen);     // (2,6)-move (Sec. 2.3.1)
+    template <int VS, int S> bool moveDelete(Vertex::Label v, Xoshiro256pp &gen); // (6,2)-move (Sec. 2.3.1)
+    template <int S> bool moveFlip(Tetra::Label t012, Xoshiro256pp &gen); // (4,4)-move (Sec. 2.3.2)
+    template <int VS> bool moveShift(Tetra::Label t, Xoshiro256pp &gen);   // (2,3)-move upward (Sec. 2.3.3)
+    template <int VS> bool moveShiftD(Tetra::Label tv, Xoshiro256pp &gen); // (2,3)-move downward
+    template <int VS> bool moveShiftI(Tetra::Label t, Xoshiro256pp &gen);  // (3,2)-move upward (ishift)
+    template <int VS> bool moveShiftID(Tetra::Label t31, Xoshiro256pp &gen); // (3,2)-move downward (ishift)
     // Comment: Wrappers for Universe moves; return success status.
     // HPC Target: [GPU #7]
 
-    static void prepare();  // Prepares for measurements
+    void writeCheckpoint(std::string outFile, int phase, int sweep);
+    bool readCheckpoint(std::string outFile, int &phase, int &sweep);
+    // Comment: Full-state checkpointing (Sec. 3.3): geometry snapshot plus couplings,
+    // every rng engine (move, sweep threads, Bags, observables) and the sweep index.
+    // Written at the periodic-export cadence; a resumed run continues bit-exactly,
+    // so a node failure costs at most one export interval instead of the full
+    // thermalization. Observable data files are append-mode and carry themselves.
+
+    void prepare();  // Prepares for measurements
     // Comment: Likely calls Universe::updateGeometry (Sec. 3.2, 3.3.3).
     // HPC Target: [OpenMP #3]
 
-    static void tune();  // Tunes coupling constants
-    // Comment: Adjusts k3 to pseudocritical value (Sec. 3.3.1).
+    // Move-trace recording (see traceFile above). The hot-path cost when off is
+    // one predictable branch per accepted move; records are buffered and written
+    // in 64 KiB blocks like the observable output.
+    bool traceActive = false;      // Raised by traceOpen() for this run
+    std::ofstream traceStream;     // The open trace file
+    std::string tracePending;      // Records not yet written
+    void traceOpen();                                        // Opens traceFile, writes the magic
+    void traceRecord(int type, int a0, int a1, int a2);      // Appends one accepted move
+    void traceClose();                                       // Final flush at the end of start()
+
+    void tune();  // Tunes coupling constants
+    // Comment: Adjusts k3 to pseudocritical value (Sec. 3.3.1). The ladder walks
+    // fixed delta_k3 multiples per sweep; with autotune on, a secant fit of the
+    // measured volume response replaces the ladder once enough history exists.
+
+    // Autotuner state (Sec. 3.3.1); persisted in the checkpoint so a resumed
+    // run continues the same controller trajectory bit-exactly.
+    double tuneWinK3 = 0;        // Accumulators for the current (k3, N) window
+    double tuneWinN = 0;
+    int tuneWinCount = 0;
+    double tunePrevK3 = 0;       // Mean of the last completed window
+    double tunePrevN = 0;
+    bool tunePrevValid = false;
+    double tuneSlope = 0;        // Smoothed secant estimate of d<N>/dk3 (< 0)
+    bool tuneSlopeValid = false;
+    int tuneStableSweeps = 0;    // Consecutive sweeps meeting the equilibrium test
+    bool thermalDone = false;    // Raised by tune(); start() then ends the phase
+    int lastSweepNetGrow = 0;    // Accepted adds minus deletes in the last sweep
+    // Comment: The add/delete imbalance is the drift term of the volume random
+    // walk; performSweep() already counts it, so equilibrium detection costs
+    // nothing extra per attempt.
 };
 
 // HPC Targets Summary:
 // [OpenMP #1]: Parallelize performSweep() for sweeps (Sec. 3.3).
 // [OpenMP #2]: Parallelize observable measurements (Sec. 3.4).
 // [OpenMP #3]: Parallelize prepare() if BFS involved (Sec. 3.2).
-// [MPI #4]: Distribute start() across nodes; fix static rng.
+// [MPI #4]: Distribute start() across nodes; instances already carry their own rng.
 // [GPU #7]: Accelerate move attempts in attemptMove(), move*().
 // [General #12]: Dynamically tune sweep size in performSweep().
\ No newline at end of file
@@ -0,0 +1,184 @@
+// Copyright 2021 Joren Brunekreef, Daniel Nemeth and Andrzej Görlich
+/****
+ *
+ * Stats is a compile-time-optional instrumentation layer for the
+ * move/sweep hot path. Build with `make STATS=1` to enable it; without
+ * the flag every CDT_STATS_* macro below expands to nothing and the
+ * hot path is untouched.
+ *
+ * It keeps, per thread, cache-line-padded counters of move attempts,
+ * geometric-precondition rejections, Metropolis rejections, accepts and
+ * cycle counts for each move kind, plus call/cycle totals for the
+ * prepare/observable/checkpoint phases, and appends them periodically
+ * as machine-readable records to <outfile>.stats. This answers whether
+ * a slow job is rejection-bound, BFS-bound or I/O-bound without
+ * attaching an external profiler.
+ *
+ ****/
+#pragma once  // Prevents multiple inclusions
+// Comment: Standard header guard.
+
+#ifdef CDT_STATS
+
+#include <cstdint>   // For uint64_t counters
+#include <string>    // For the output file name
+#include <vector>    // For the counter-block registry
+#include <mutex>     // For registry/free-list guards
+#include <fstream>   // For the append-mode record writer
+#include <chrono>    // For the cycle-counter fallback off x86
+
+namespace stats {
+
+enum MoveKind { ADD, DEL, FLIP, SHIFT, SHIFTD, ISHIFT, ISHIFTD, MOVE_KINDS };
+enum PhaseKind { PREPARE, OBSERVE3D, OBSERVE2D, CHECKPOINT, PHASE_KINDS };
+// Comment: One slot per move wrapper in simulation.cpp and per engine phase.
+
+inline uint64_t cycles() {  // Serialization-free timestamp for interval accumulation
+#if defined(__x86_64__)
+    unsigned lo, hi;
+    asm volatile("rdtsc" : "=a"(lo), "=d"(hi));
+    return (static_cast<uint64_t>(hi) << 32) | lo;
+#else
+    return std::chrono::steady_clock::now().time_since_epoch().count();  // ns, not cycles
+#endif
+}
+
+struct alignas(64) MoveCounters {  // One cache line per move kind: no false sharing
+    uint64_t attempts = 0;       // Wrapper entries (after a valid seed was drawn)
+    uint64_t geomRejects = 0;    // Precondition failures (type/face checks, Universe refusals)
+    uint64_t metroRejects = 0;   // Metropolis accept-step failures
+    uint64_t accepts = 0;        // Moves actually applied
+    uint64_t cycles = 0;         // Total cycles inside the wrapper
+};
+
+struct alignas(64) PhaseCounters {
+    uint64_t calls = 0;   // Phase entries
+    uint64_t cycles = 0;  // Total cycles inside the phase
+};
+
+struct ThreadCounters {  // One block per concurrently live thread
+    MoveCounters moves[MOVE_KINDS];
+    PhaseCounters phases[PHASE_KINDS];
+};
+
+inline std::mutex &guard() { static std::mutex m; return m; }
+inline std::vector<ThreadCounters *> &registry() {  // All blocks ever handed out; emit() sums these
+    static std::vector<ThreadCounters *> r;
+    return r;
+}
+inline std::vector<ThreadCounters *> &freeList() {  // Blocks returned by exited threads
+    static std::vector<ThreadCounters *> f;
+    return f;
+}
+
+struct ThreadSlot {  // Binds a counter block to the current thread for its lifetime
+    ThreadCounters *block;
+    ThreadSlot() {
+        std::lock_guard<std::mutex> lock(guard());
+        if (freeList().empty()) {
+            block = new ThreadCounters();
+            registry().push_back(block);
+        } else {
+            block = freeList().back();  // Sweep workers are respawned every phase; reuse
+            freeList().pop_back();      // their blocks so the registry stays bounded by
+        }                               // the peak concurrent thread count
+    }
+    ~ThreadSlot() {
+        std::lock_guard<std::mutex> lock(guard());
+        freeList().push_back(block);  // Counters stay registered; totals remain cumulative
+    }
+};
+
+inline ThreadCounters &local() {  // The calling thread's counter block
+    static thread_local ThreadSlot slot;
+    return *slot.block;
+}
+
+inline bool classify(MoveKind m, bool applied) {  // Tags a Universe move result
+    if (applied) local().moves[m].accepts++;
+    else local().moves[m].geomRejects++;  // Universe-level refusal (e.g., strictness)
+    return applied;
+}
+
+struct MoveTimer {  // Scope guard: one attempt, cycles on exit
+    MoveCounters &c;
+    uint64_t t0;
+    explicit MoveTimer(MoveKind m) : c(local().moves[m]), t0(cycles()) { c.attempts++; }
+    ~MoveTimer() { c.cycles += cycles() - t0; }
+};
+
+struct PhaseTimer {
+    PhaseCounters &c;
+    uint64_t t0;
+    explicit PhaseTimer(PhaseKind p) : c(local().phases[p]), t0(cycles()) { c.calls++; }
+    ~PhaseTimer() { c.cycles += cycles() - t0; }
+};
+
+inline void emit(std::string outFile, int phase, int sweep) {  // Appends one cumulative record
+    if (outFile == "") return;  // No output geometry configured: nowhere to anchor the file
+    static const char *moveNames[MOVE_KINDS] = {"add", "delete", "flip", "shift", "shiftd", "ishift", "ishiftd"};
+    static const char *phaseNames[PHASE_KINDS] = {"prepare", "obs3d", "obs2d", "checkpoint"};
+
+    ThreadCounters sum;
+    {
+        std::lock_guard<std::mutex> lock(guard());
+        for (auto *tc : registry()) {
+            for (int m = 0; m < MOVE_KINDS; m++) {
+                sum.moves[m].attempts += tc->moves[m].attempts;
+                sum.moves[m].geomRejects += tc->moves[m].geomRejects;
+                sum.moves[m].metroRejects += tc->moves[m].metroRejects;
+                sum.moves[m].accepts += tc->moves[m].accepts;
+                sum.moves[m].cycles += tc->moves[m].cycles;
+            }
+            for (int p = 0; p < PHASE_KINDS; p++) {
+                sum.phases[p].calls += tc->phases[p].calls;
+                sum.phases[p].cycles += tc->phases[p].cycles;
+            }
+        }
+    }
+    // Comment: Counters are process-wide; with replicas > 1 each replica's file
+    // carries the combined totals of all engines sharing the process.
+
+    std::ofstream file(outFile + ".stats", std::ios::app);
+    if (!file.is_open()) return;
+    if (file.tellp() == 0) {  // Header once, for machine-readable consumers
+        file << "# phase sweep";
+        for (int m = 0; m < MOVE_KINDS; m++)
+            file << " " << moveNames[m] << ":attempts:geomrej:metrorej:accepts:cycles";
+        for (int p = 0; p < PHASE_KINDS; p++)
+            file << " " << phaseNames[p] << ":calls:cycles";
+        file << "\n# cumulative since process start; difference consecutive records for rates\n";
+    }
+    file << phase << " " << sweep;
+    for (int m = 0; m < MOVE_KINDS; m++)
+        file << " " << sum.moves[m].attempts << ":" << sum.moves[m].geomRejects << ":"
+             << sum.moves[m].metroRejects << ":" << sum.moves[m].accepts << ":" << sum.moves[m].cycles;
+    for (int p = 0; p < PHASE_KINDS; p++)
+        file << " " << sum.phases[p].calls << ":" << sum.phases[p].cycles;
+    file << "\n";
+}
+
+}  // namespace stats
+
+#define CDT_STATS_MOVE_SCOPE(kind) stats::MoveTimer cdtStatsMoveTimer(stats::kind)
+#define CDT_STATS_GEOM_REJECT(kind) stats::local().moves[stats::kind].geomRejects++
+#define CDT_STATS_METRO_REJECT(kind) stats::local().moves[stats::kind].metroRejects++
+#define CDT_STATS_RESULT(kind, expr) stats::classify(stats::kind, (expr))
+#define CDT_STATS_PHASE_SCOPE(kind) stats::PhaseTimer cdtStatsPhaseTimer(stats::kind)
+#define CDT_STATS_EMIT(outFile, phase, sweep) stats::emit(outFile, phase, sweep)
+
+#else  // !CDT_STATS: every hook compiles away
+
+#define CDT_STATS_MOVE_SCOPE(kind)
+#define CDT_STATS_GEOM_REJECT(kind)
+#define CDT_STATS_METRO_REJECT(kind)
+#define CDT_STATS_RESULT(kind, expr) (expr)
+#define CDT_STATS_PHASE_SCOPE(kind)
+#define CDT_STATS_EMIT(outFile, phase, sweep)
+
+#endif  // CDT_STATS
+
+// HPC Targets Summary:
+// [General #12]: Rejection/cycle breakdown per move kind guides sweep-size tuning.
+// [OpenMP #1]: Padded per-thread blocks make counting race- and false-sharing-free.
+// [MPI #4]: Per-process records; rank-suffixed outfiles keep distributed runs separate.
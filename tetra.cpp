@@ -1,6 +1,28 @@
 // Copyright 2021 Joren Brunekreef, Daniel Nemeth and Andrzej Görlich
+#include <mutex>      // Serializes SoA mirror chunk backing
 #include "tetra.hpp"  // Includes Tetra class definition
 
+uint8_t **Tetra::soaType = nullptr;  // SoA mirror storage; backed on demand by soaBack()
+int **Tetra::soaNbr = nullptr;
+
+void Tetra::soaBack(int t) {  // Allocates the pointer tables and the chunk containing t
+    static std::mutex mtx;
+    std::lock_guard<std::mutex> lock(mtx);
+    unsigned nChunks = pool_capacity() >> chunk_shift;
+    if (soaType == nullptr) {  // Tables sized once, from the reserved Pool capacity,
+        soaType = new uint8_t *[nChunks]();  // and never relocated: unlocked reads from
+        soaNbr = new int *[nChunks]();       // other threads stay safe (as in Pool::at)
+    }
+    unsigned c = static_cast<unsigned>(t) >> chunk_shift;
+    assert(c < nChunks);
+    if (soaType[c] == nullptr) {
+        soaType[c] = new uint8_t[chunk_size]();
+        soaNbr[c] = new int[chunk_size << 2];
+    }
+}
+// Comment: Mirrors Pool's chunking so the mirror's RSS grows with the same chunks
+// the arena actually backs; both views cost 17 bytes per reached slot.
+
 // Comment: This is the implementation file for the Tetra class, representing 3-simplices (tetrahedra) in 3D CDT (Sec. 2.3, 3.2.2).
 // Note: Contains no additional code beyond the header inclusion; all Tetra methods are defined inline in tetra.hpp.
 
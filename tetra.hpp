@@ -4,6 +4,7 @@
 
 #include <iostream>      // For printf in log()
 #include <typeinfo>      // Unused; possibly for debugging (not in this code)
+#include <cstdint>       // For the packed uint8_t type mirror
 #include "pool.hpp"      // Pool template for O(1) memory management (Sec. 3.1.1)
 #include "vertex.hpp"    // Vertex class for vertex references
 #include "halfedge.hpp"  // HalfEdge class for edge connectivity
@@ -14,9 +15,9 @@ class Tetra : public Pool<Tetra> {  // Inherits from Pool for efficient manageme
 // Comment: Manages tetrahedra, the fundamental building blocks of 3D CDT (Sec. 2.3).
 
 public:
-    static const unsigned pool_size = 5000000;  // Maximum number of tetrahedra in Pool
-    // Comment: Defines capacity C (Sec. 3.1.1), set to 5 million. Limits system size.
-    // HPC Target [General #10]: Fixed size aids cache but could be dynamic for larger N_3.
+    static const unsigned pool_size = 5000000;  // Default tetrahedron capacity (Sec. 3.1.1)
+    // Comment: Used when the config file sets no "maxtetras" key; Pool storage is
+    // chunked and demand-allocated, so large ceilings cost RSS only when reached.
 
     enum Type { THREEONE, ONETHREE, TWOTWO };  // Tetrahedron types (Sec. 2.3)
     // Comment: THREEONE: (3,1), ONETHREE: (1,3), TWOTWO: (2,2) based on vertex time distribution.
@@ -44,6 +45,7 @@ public:
 
         vs = {v0, v1, v2, v3};  // Assign vertices
         time = v0->time;  // Set slab time (typically lower time)
+        soaRecordType();  // Keep the packed type mirror coherent
     }
     // Comment: Called during initialization or moves (e.g., Sec. 2.3.1 move26).
 
@@ -70,6 +72,7 @@ public:
 
     void setTetras(Pool<Tetra>::Label t0, Pool<Tetra>::Label t1, Pool<Tetra>::Label t2, Pool<Tetra>::Label t3) {
         tnbr = {t0, t1, t2, t3};  // Set neighboring tetra labels
+        soaRecordNeighbors();  // Keep the flat neighbor mirror coherent
     }
     // Comment: Defines adjacency (Sec. 2.3, Fig. 3-5); updated in moves.
 
@@ -128,7 +131,7 @@ public:
 
     void exchangeTetraOpposite(Vertex::Label v, Tetra::Label tn) {
         for (int i = 0; i < 4; i++) {  // Replace neighbor opposite v
-            if (vs[i] == v) tnbr[i] = tn;
+            if (vs[i] == v) { tnbr[i] = tn; soaRecordNeighbor(i); }
         }
     }
     // Comment: Updates connectivity during moves (e.g., Sec. 2.3.1).
@@ -150,6 +153,49 @@ public:
     std::array<Pool<HalfEdge>::Label, 3> hes = {-1, -1, -1};  // Three half-edge labels (for (3,1))
     // Comment: Core data (Sec. 3.2.2, Fig. 7). Public access noted for refactoring.
     // HPC Target [General #10]: Contiguous arrays optimize cache.
+
+    // SoA mirror of the hot fields (Sec. 3.1.1). The pooled object packs type, time,
+    // vs, tnbr and hes into one line-plus cache footprint, so loops that need only
+    // the type (proposal validation, the (2,2)-chain walks) or only the neighbors
+    // (the sphereDual BFS) drag the whole object through cache. These static views
+    // are kept coherent by setVertices()/setTetras()/exchangeTetraOpposite() and
+    // mirror the Pool's chunk layout: the pointer tables are allocated once and the
+    // data chunks backed on demand, so readers never lock and RSS stays demand-paged.
+    static Type typeOf(Label t) {  // Packed type read: 1 byte per tetra
+        return static_cast<Type>(soaType[t >> chunk_shift][t & (chunk_size - 1)]);
+    }
+    static Label neighborOf(Label t, int i) {  // Flat neighbor read: 4 ints per tetra
+        return soaNbr[t >> chunk_shift][((t & (chunk_size - 1)) << 2) + i];
+    }
+
+    void soaSync() {  // Re-mirrors all hot fields; for code that writes them directly
+        soaRecordType();
+        soaRecordNeighbors();
+    }
+
+private:
+    static uint8_t **soaType;  // Chunked packed type array (same geometry as the Pool)
+    static int **soaNbr;       // Chunked flat 4-wide neighbor array
+    static void soaBack(int t);  // Backs the chunk containing t (defined in tetra.cpp)
+
+    void soaRecordType() {
+        Label l = *this;  // Current tetra label
+        int ix = l;
+        if (soaType == nullptr || soaType[ix >> chunk_shift] == nullptr) soaBack(ix);
+        soaType[ix >> chunk_shift][ix & (chunk_size - 1)] = static_cast<uint8_t>(type);
+    }
+    void soaRecordNeighbors() {
+        Label l = *this;
+        int ix = l;
+        if (soaNbr == nullptr || soaNbr[ix >> chunk_shift] == nullptr) soaBack(ix);
+        int *row = soaNbr[ix >> chunk_shift] + ((ix & (chunk_size - 1)) << 2);
+        for (int i = 0; i < 4; i++) row[i] = tnbr[i];
+    }
+    void soaRecordNeighbor(int i) {
+        Label l = *this;  // Chunk already backed: the tetra was fully set up at creation
+        int ix = l;
+        soaNbr[ix >> chunk_shift][((ix & (chunk_size - 1)) << 2) + i] = tnbr[i];
+    }
 };
 
 // HPC Targets Summary:
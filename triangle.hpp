@@ -12,9 +12,9 @@ class Triangle : public Pool<Triangle> {  // Inherits from Pool for efficient ma
 // Comment: Manages triangles (spatial faces of (3,1)-tetrahedra, Sec. 3.2.2) with O(1) operations (Sec. 3.1.1).
 
 public:
-    static const unsigned pool_size = 1000000;  // Maximum number of triangles in Pool
-    // Comment: Defines capacity C for Pool (Sec. 3.1.1), set to 1 million. Limits system size.
-    // HPC Target [General #10]: Fixed size aids cache but could be dynamic for scalability.
+    static const unsigned pool_size = 1000000;  // Default triangle capacity (Sec. 3.1.1)
+    // Comment: Used when the config file sets no "maxtriangles" key; Pool storage is
+    // chunked and demand-allocated.
 
     int time;  // Slice number
     // Comment: Time slice (S^1 direction, Sec. 2.3) of the spatial S^2 slice containing this triangle.
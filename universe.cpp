@@ -2,58 +2,77 @@
 #include <fstream>        // For file I/O (initialize, exportGeometry)
 #include <algorithm>      // For std::find, std::fill
 #include <unordered_map>  // For vertex/tetra mapping in exportGeometry
+#include <mutex>          // For guarding the dirty-vertex set under parallel sweeps
+#include <thread>         // For the background geometry export writer
+#include <cstdint>        // For int32_t records in the binary geometry format
+#include <sys/mman.h>     // For mmap in the binary initialize() fast path
+#include <sys/stat.h>     // For fstat (binary file size)
+#include <fcntl.h>        // For open (binary file descriptor)
+#include <unistd.h>       // For read/close
 #include "universe.hpp"   // Universe class definition
+#include "marker.hpp"     // Epoch-stamped visited buffers for the adjacency BFS
 
-// Static member initializations (Sec. 3)
-int Universe::nSlices = 0;  // Number of time slices (S^1, Sec. 2.3)
-std::vector<int> Universe::slabSizes;  // Tetrahedra between slices
-std::vector<int> Universe::sliceSizes; // Vertices per spatial slice (S^2)
-std::string Universe::fID;             // File identifier
-std::string Universe::OutFile;         // Output file name
-int Universe::strictness;              // Manifold strictness (Sec. 1.3)
-int Universe::volfix_switch;           // Volume fixing toggle (Sec. 2.4)
-std::default_random_engine Universe::rng(0);  // RNG for moves (Sec. 2.1)
-// HPC Target [MPI #4]: Static RNG needs per-rank instances for distributed runs.
-Bag<Tetra, Tetra::pool_size> Universe::tetrasAll(rng);  // All tetrahedra (Sec. 3.1.2)
-Bag<Tetra, Tetra::pool_size> Universe::tetras31(rng);   // (3,1)-tetrahedra
-Bag<Vertex, Vertex::pool_size> Universe::verticesAll(rng);  // All vertices
-Bag<Vertex, Vertex::pool_size> Universe::verticesSix(rng);  // Vertices with cnum=6 (Sec. 2.3.1)
-
-std::vector<Vertex::Label> Universe::vertices;         // Vertex labels
-std::vector<Tetra::Label> Universe::tetras;           // Tetra labels
-std::vector<HalfEdge::Label> Universe::halfEdges;     // Half-edge labels
-std::vector<Triangle::Label> Universe::triangles;     // Triangle labels
-std::vector<std::vector<Vertex::Label>> Universe::vertexNeighbors;  // Vertex adjacency
-std::vector<std::array<Triangle::Label, 3>> Universe::triangleNeighbors;  // Triangle adjacency
-// HPC Target [General #10]: Pre-allocate vectors for cache efficiency.
+// Comment: One Universe instance per replica; the Bags bind to the instance RNG (Sec. 3.1.2).
+Universe::Universe() : rng(0), tetrasAll(rng), tetras31(rng), verticesAll(rng), verticesSix(rng) {}
+// HPC Target [MPI #4]: Per-instance RNG keeps distributed/replica runs independent.
+
+static const int32_t binaryGeometryMagic = 0x54444342;  // "BCDT"; leading tag of binary geometry files
 
 bool Universe::initialize(std::string geometryFilename, std::string fID_, int strictness_, int volfix_switch_) {
     fID = fID_;  // Set file ID
-    std::ifstream infile(geometryFilename.c_str());  // Open input geometry file
-    assert(!infile.fail());  // Ensure file opened successfully
 
     strictness = strictness_;  // Set manifold strictness
     volfix_switch = volfix_switch_;  // Set volume fixing switch
 
+    // Binary fast path: fixed-width int32 records behind a magic tag, mmapped so a
+    // multi-million-tetra geometry loads without per-number text parsing. Text files
+    // (no tag) fall through to the original stream parser for interchange.
+    int fd = open(geometryFilename.c_str(), O_RDONLY);
+    assert(fd >= 0);  // Ensure file opened successfully
+    struct stat st;
+    fstat(fd, &st);
+    int32_t magic = 0;
+    if (st.st_size >= static_cast<off_t>(sizeof(int32_t))) {
+        ssize_t got = read(fd, &magic, sizeof(int32_t));
+        if (got != sizeof(int32_t)) magic = 0;
+    }
+    void *map = nullptr;            // mmapped region (binary only)
+    const int32_t *bin = nullptr;   // Record cursor into the mapped region
+    std::ifstream infile;
+    if (magic == binaryGeometryMagic) {
+        map = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        assert(map != MAP_FAILED);
+        bin = reinterpret_cast<const int32_t *>(map) + 1;  // Skip magic tag
+    } else {
+        infile.open(geometryFilename.c_str());
+        assert(!infile.fail());
+    }
+    close(fd);  // mmap holds its own reference to the file
+    auto nextInt = [&]() {  // Uniform record reader for both formats
+        int x;
+        if (bin) { x = *bin++; } else { infile >> x; }
+        return x;
+    };
+
     bool ordered;  // Flag for tetrahedron ordering convention
-    infile >> ordered;  // Read ordering flag
+    ordered = nextInt();  // Read ordering flag
 
     int n0;  // Number of vertices
-    infile >> n0;
+    n0 = nextInt();
     printf("n0: %d\n", n0);  // Log vertex count
     int line;  // Temp variable for file validation
 
     int maxTime = 0;  // Max time slice
     std::vector<Vertex::Label> vs(n0);  // Temporary vertex storage
     for (int i = 0; i < n0; i++) {
-        infile >> line;  // Read vertex time
+        line = nextInt();  // Read vertex time
         auto v = Vertex::create();  // Create vertex (Sec. 3.1.1)
         verticesAll.add(v);  // Add to Bag
         v->time = line;  // Set time slice
         vs.at(i) = v;
         if (v->time > maxTime) maxTime = v->time;  // Track max time
     }
-    infile >> line;
+    line = nextInt();
     if (line != n0) return false;  // Validate vertex count
 
     nSlices = maxTime + 1;  // Set number of slices
@@ -63,28 +82,34 @@ bool Universe::initialize(std::string geometryFilename, std::string fID_, int st
     std::fill(sliceSizes.begin(), sliceSizes.end(), 0);
 
     int n3;  // Number of tetrahedra
-    infile >> n3;
+    n3 = nextInt();
     printf("n3: %d\n", n3);  // Log tetra count
+    std::vector<Tetra::Label> ts(n3);  // File index -> Pool label
+    for (int i = 0; i < n3; i++) ts.at(i) = Tetra::create();  // Create tetrahedra (Sec. 3.1.1)
+    // Comment: Pre-created so the file's forward neighbor references resolve. File
+    // indices are mapped through vs/ts: with replicas sharing one Pool arena, a
+    // fresh label no longer equals its file index.
     for (int i = 0; i < n3; i++) {
-        auto t = Tetra::create();  // Create tetrahedron (Sec. 3.1.1)
-        int tvs[4];  // Vertex labels
-        for (int j = 0; j < 4; j++) infile >> tvs[j];  // Read vertices
-        int tts[4];  // Neighbor tetra labels
-        for (int j = 0; j < 4; j++) infile >> tts[j];  // Read neighbors
+        auto t = ts.at(i);
+        int tvs[4];  // Vertex file indices
+        for (int j = 0; j < 4; j++) tvs[j] = nextInt();  // Read vertices
+        int tts[4];  // Neighbor tetra file indices
+        for (int j = 0; j < 4; j++) tts[j] = nextInt();  // Read neighbors
 
-        t->setVertices(tvs[0], tvs[1], tvs[2], tvs[3]);  // Set tetra vertices
+        t->setVertices(vs.at(tvs[0]), vs.at(tvs[1]), vs.at(tvs[2]), vs.at(tvs[3]));  // Set tetra vertices
         if (t->is31()) {  // If (3,1)-tetra (Sec. 2.3)
-            for (int j = 0; j < 3; j++) Pool<Vertex>::at(tvs[j])->tetra = t;  // Link to base vertices
+            for (int j = 0; j < 3; j++) vs.at(tvs[j])->tetra = t;  // Link to base vertices
         }
-        t->setTetras(tts[0], tts[1], tts[2], tts[3]);  // Set tetra neighbors
+        t->setTetras(ts.at(tts[0]), ts.at(tts[1]), ts.at(tts[2]), ts.at(tts[3]));  // Set tetra neighbors
 
         tetrasAll.add(t);  // Add to all tetra Bag
         if (t->is31()) tetras31.add(t);  // Add to (3,1) Bag
         slabSizes.at(t->vs[1]->time) += 1;  // Update slab size
         if (t->is31()) sliceSizes.at(t->vs[0]->time) += 1;  // Update slice size
     }
-    infile >> line;
+    line = nextInt();
     if (line != n3) return false;  // Validate tetra count
+    if (map) munmap(map, st.st_size);  // Release binary mapping
     printf("read %s\n", geometryFilename.c_str());
 
     if (!ordered) {  // Reorder tetrahedra if not in convention (Sec. 3.2.2)
@@ -102,21 +127,20 @@ bool Universe::initialize(std::string geometryFilename, std::string fID_, int st
         }
     }
 
-    for (auto v : vs) {  // Compute initial coordination numbers (Sec. 3.2.2)
-        int cnum = 0, scnum = 0;
-        for (auto t : tetrasAll) {
-            if (t->hasVertex(v)) cnum++;  // Total tetrahedra count
-            if (!t->is31()) continue;
-            if (t->hasVertex(v) && t->vs[3] != v) scnum++;  // Spatial neighbors in (3,1)
-        }
-        v->scnum = scnum;
-        v->cnum = cnum;
+    for (auto v : vs) { v->cnum = 0; v->scnum = 0; }  // Pool slots are recycled unscrubbed
+    for (auto t : tetrasAll) {  // Accumulate coordination numbers in one incidence pass (Sec. 3.2.2)
+        for (int j = 0; j < 4; j++) t->vs[j]->cnum++;  // Every tetra counts for its four vertices
+        if (!t->is31()) continue;
+        for (int j = 0; j < 3; j++) t->vs[j]->scnum++;  // Base incidences = spatial degree on the S^2 slice
     }
+    // Comment: O(n3) instead of the old O(n0*n3) vertex-times-tetra scan, which
+    // dominated the load time of large thermalized geometries.
+    for (auto v : vs) updateVerticesSix(v);  // Seed the (6,2)-move candidate Bag
     return true;  // Initialization successful
     // HPC Target [General #10]: Pre-allocate vs, slabSizes for cache efficiency.
 }
 
-bool Universe::exportGeometry(std::string geometryFilename) {
+std::vector<int> Universe::buildGeometryRecords() {
     updateGeometry();  // Ensure latest state (Sec. 3.2)
 
     std::unordered_map<int, int> vertexMap;  // Map Vertex::Label to file index
@@ -137,25 +161,272 @@ bool Universe::exportGeometry(std::string geometryFilename) {
         i++;
     }
 
-    std::string out = "1\n";  // Indicate ordered tetrahedra
-    out += std::to_string(vertices.size()) + "\n";  // Vertex count
-    for (auto v : intVMap) out += std::to_string(v->time) + "\n";  // Vertex times
-    out += std::to_string(vertices.size()) + "\n";  // Vertex count check
-    out += std::to_string(tetrasAll.size()) + "\n";  // Tetra count
+    std::vector<int> dat;  // Full record sequence, shared by the binary and text writers
+    dat.reserve(5 + vertices.size() + 8 * tetrasAll.size());
+    dat.push_back(1);  // Indicate ordered tetrahedra
+    dat.push_back(vertices.size());  // Vertex count
+    for (auto v : intVMap) dat.push_back(v->time);  // Vertex times
+    dat.push_back(vertices.size());  // Vertex count check
+    dat.push_back(tetrasAll.size());  // Tetra count
+    for (auto t : intTMap) {  // Tetrahedra records
+        for (auto v : t->vs) dat.push_back(vertexMap[v]);
+        for (auto tn : t->tnbr) dat.push_back(tetraMap[tn]);
+    }
+    dat.push_back(tetrasAll.size());  // Tetra count check
+    return dat;
+}
 
-    for (auto t : intTMap) {  // Write tetrahedra data
-        for (auto v : t->vs) out += std::to_string(vertexMap[v]) + "\n";
-        for (auto tn : t->tnbr) out += std::to_string(tetraMap[tn]) + "\n";
+void Universe::writeGeometryRecords(const std::vector<int> &dat, std::string geometryFilename) {
+    // Binary format ('.bcdt' extension): the records as fixed-width int32 behind a
+    // magic tag, written in one block. Avoids the per-number std::to_string cost
+    // that stalls the sweep loop on large geometries.
+    bool binary = geometryFilename.size() > 5 &&
+        geometryFilename.compare(geometryFilename.size() - 5, 5, ".bcdt") == 0;
+    if (binary) {
+        std::vector<int32_t> rec(dat.begin(), dat.end());  // Fixed-width on-disk records
+        std::ofstream file(geometryFilename, std::ios::out | std::ios::trunc | std::ios::binary);
+        assert(file.is_open());
+        file.write(reinterpret_cast<const char *>(&binaryGeometryMagic), sizeof(int32_t));
+        file.write(reinterpret_cast<const char *>(rec.data()), rec.size() * sizeof(int32_t));
+        file.close();
+        std::cout << geometryFilename << "\n";
+        return;
     }
-    out += std::to_string(tetrasAll.size());  // Tetra count check
+
+    std::string out;  // Text format: one record per line
+    for (auto r : dat) out += std::to_string(r) + "\n";
 
     std::ofstream file(geometryFilename, std::ios::out | std::ios::trunc);
     assert(file.is_open());
-    file << out << "\n";
+    file << out;
     file.close();
     std::cout << geometryFilename << "\n";
+    // HPC Note: Text path kept for interchange; prefer '.bcdt' for checkpoints.
+}
+
+bool Universe::exportGeometry(std::string geometryFilename) {
+    writeGeometryRecords(buildGeometryRecords(), geometryFilename);  // Synchronous export
     return true;  // Export successful
-    // HPC Note: String concatenation inefficient; minimal impact unless frequent.
+}
+
+void Universe::exportGeometryAsync(std::string geometryFilename) {
+    finishExports();  // Double-buffer: wait for a previous write before reusing the lane
+    auto dat = buildGeometryRecords();  // Snapshot on the calling thread (cheap, in-memory)
+    exportWriter = std::thread([](std::vector<int> records, std::string fname) {
+        writeGeometryRecords(records, fname);
+    }, std::move(dat), geometryFilename);
+    // Comment: The writer owns its snapshot copy, so sweeps may resume mutating the
+    // triangulation immediately.
+}
+
+void Universe::finishExports() {
+    if (exportWriter.joinable()) exportWriter.join();
+}
+
+void Universe::canonicalizeState() {  // Align history-dependent hints with the reload path
+    for (auto t : tetrasAll) {  // Same last-writer-wins rule as initialize(), in export order
+        if (!t->is31()) continue;
+        for (int j = 0; j < 3; j++) t->vs[j]->tetra = t;
+    }
+
+    dirtyVertices.clear();  // Subsumed by the forced full rebuild below
+    vertexNeighborsValid = false;  // Next updateVertexData() re-walks from the new hints
+}
+
+void Universe::compactGeometry() {  // BFS relabeling for traversal locality, see universe.hpp
+    if (tetrasAll.size() == 0) return;
+
+    std::vector<Tetra::Label> tetraOrder;   // Discovery order of the dual-graph BFS
+    std::vector<Vertex::Label> vertexOrder; // First-touch order during the same sweep
+    std::unordered_map<int, int> tetraRank; // Label -> BFS position
+    std::unordered_map<int, int> vertexRank;
+    tetraOrder.reserve(tetrasAll.size());
+    vertexOrder.reserve(verticesAll.size());
+
+    Tetra::Label seed = *tetrasAll.begin();  // Deterministic: canonical Bag order
+    tetraRank[seed] = 0;
+    tetraOrder.push_back(seed);
+    for (unsigned head = 0; head < tetraOrder.size(); head++) {  // Vector doubles as the BFS queue
+        auto t = tetraOrder[head];
+        for (auto v : t->vs) {
+            if (vertexRank.find(v) == vertexRank.end()) {
+                vertexRank[v] = vertexOrder.size();
+                vertexOrder.push_back(v);
+            }
+        }
+        for (auto tn : t->tnbr) {
+            if (tetraRank.find(tn) == tetraRank.end()) {
+                tetraRank[tn] = tetraOrder.size();
+                tetraOrder.push_back(tn);
+            }
+        }
+    }
+    assert(tetraOrder.size() == static_cast<unsigned>(tetrasAll.size()));    // Dual graph is connected
+    assert(vertexOrder.size() == static_cast<unsigned>(verticesAll.size())); // Every vertex has a tetra
+
+    std::vector<int> tetraSlots(tetraOrder.begin(), tetraOrder.end());  // Slots this replica owns
+    std::vector<int> vertexSlots(vertexOrder.begin(), vertexOrder.end());
+    std::sort(tetraSlots.begin(), tetraSlots.end());
+    std::sort(vertexSlots.begin(), vertexSlots.end());
+    // Comment: BFS position i lands in the i-th lowest owned slot, so dual-graph
+    // neighbors become near-contiguous in memory without touching the shared free
+    // list — other replicas' labels and the Pool arena itself are left alone.
+
+    struct TetraSnap { int time; Tetra::Type type; std::array<int, 4> vs; std::array<int, 4> tnbr; };
+    struct VertexSnap { int time; int scnum; int cnum; int tetra; };
+    std::vector<TetraSnap> tetraSnap(tetraOrder.size());  // Field snapshot with relabeled references
+    for (unsigned i = 0; i < tetraOrder.size(); i++) {
+        auto t = tetraOrder[i];
+        tetraSnap[i].time = t->time;
+        tetraSnap[i].type = t->type;
+        for (int j = 0; j < 4; j++) tetraSnap[i].vs[j] = vertexSlots[vertexRank.at(t->vs[j])];
+        for (int j = 0; j < 4; j++) tetraSnap[i].tnbr[j] = tetraSlots[tetraRank.at(t->tnbr[j])];
+    }
+    std::vector<VertexSnap> vertexSnap(vertexOrder.size());
+    for (unsigned i = 0; i < vertexOrder.size(); i++) {
+        auto v = vertexOrder[i];
+        vertexSnap[i].time = v->time;
+        vertexSnap[i].scnum = v->scnum;
+        vertexSnap[i].cnum = v->cnum;
+        vertexSnap[i].tetra = tetraSlots[tetraRank.at(v->tetra)];
+    }
+
+    for (auto t : tetraOrder) {  // Empty the Bags before the slots are overwritten
+        if (tetras31.contains(t)) tetras31.remove(t);
+        tetrasAll.remove(t);
+    }
+    for (auto v : vertexOrder) {
+        if (verticesSix.contains(v)) verticesSix.remove(v);
+        verticesAll.remove(v);
+    }
+
+    for (unsigned i = 0; i < tetraSnap.size(); i++) {  // Write every object into its new slot
+        Tetra::Label t = tetraSlots[i];
+        t->time = tetraSnap[i].time;
+        t->type = tetraSnap[i].type;
+        for (int j = 0; j < 4; j++) t->vs[j] = tetraSnap[i].vs[j];
+        for (int j = 0; j < 4; j++) t->tnbr[j] = tetraSnap[i].tnbr[j];
+        t->hes = {-1, -1, -1};  // Spatial structures are rebuilt below
+        t->soaSync();  // Direct field writes above bypass the SoA mirror hooks
+    }
+    for (unsigned i = 0; i < vertexSnap.size(); i++) {
+        Vertex::Label v = vertexSlots[i];
+        v->time = vertexSnap[i].time;
+        v->scnum = vertexSnap[i].scnum;
+        v->cnum = vertexSnap[i].cnum;
+        v->tetra = vertexSnap[i].tetra;
+    }
+
+    for (unsigned i = 0; i < tetraSnap.size(); i++) {  // Refill the Bags in BFS order
+        Tetra::Label t = tetraSlots[i];
+        tetrasAll.add(t);
+        if (t->is31()) tetras31.add(t);
+    }
+    for (unsigned i = 0; i < vertexSnap.size(); i++) {
+        Vertex::Label v = vertexSlots[i];
+        verticesAll.add(v);
+        if (v->cnum == 6 && v->scnum == 3) verticesSix.add(v);
+    }
+    // Comment: Element order is part of the reproducible state (pick() maps through
+    // it), so the refill order matters: BFS order is a pure function of the geometry
+    // and the previous canonical order, keeping resumed runs aligned.
+
+    dirtyVertices.clear();  // All staged adjacency references old labels
+    vertexNeighborsValid = false;
+    dirtyTetras31.clear();
+    spatialValid = false;
+    // Comment: The next prepare() does a full rebuild; the stale half-edges and
+    // triangles are reclaimed by that rebuild's destroy pass as usual.
+}
+
+void Universe::saveCheckpointState(std::ostream &file) {  // Bag order + rng, see universe.hpp
+    rng.save(file);
+
+    std::unordered_map<int, int32_t> tetraIndex;  // Label -> position in canonical (export) order
+    int32_t i = 0;
+    for (auto t : tetrasAll) tetraIndex[t] = i++;
+    std::unordered_map<int, int32_t> vertexIndex;
+    i = 0;
+    for (auto v : verticesAll) vertexIndex[v] = i++;
+
+    int32_t n31 = tetras31.size();  // tetras31 element order as canonical indices
+    file.write(reinterpret_cast<const char *>(&n31), sizeof(n31));
+    for (auto t : tetras31) {
+        int32_t ix = tetraIndex[t];
+        file.write(reinterpret_cast<const char *>(&ix), sizeof(ix));
+    }
+
+    int32_t nSix = verticesSix.size();  // verticesSix element order as canonical indices
+    file.write(reinterpret_cast<const char *>(&nSix), sizeof(nSix));
+    for (auto v : verticesSix) {
+        int32_t ix = vertexIndex[v];
+        file.write(reinterpret_cast<const char *>(&ix), sizeof(ix));
+    }
+}
+
+void Universe::restoreCheckpointState(std::istream &file) {  // Inverse of saveCheckpointState()
+    rng.load(file);
+
+    std::vector<Tetra::Label> tetraAt;  // Canonical order reproduced by the geometry reload
+    for (auto t : tetrasAll) tetraAt.push_back(t);
+    std::vector<Vertex::Label> vertexAt;
+    for (auto v : verticesAll) vertexAt.push_back(v);
+
+    int32_t n31;
+    file.read(reinterpret_cast<char *>(&n31), sizeof(n31));
+    assert(n31 == tetras31.size());  // Same geometry, so the same candidate set
+    std::vector<Tetra::Label> order31(n31);
+    for (auto &t : order31) {
+        int32_t ix;
+        file.read(reinterpret_cast<char *>(&ix), sizeof(ix));
+        t = tetraAt.at(ix);
+    }
+    for (auto t : tetraAt) if (tetras31.contains(t)) tetras31.remove(t);  // Re-impose element order
+    for (auto t : order31) tetras31.add(t);
+
+    int32_t nSix;
+    file.read(reinterpret_cast<char *>(&nSix), sizeof(nSix));
+    assert(nSix == verticesSix.size());
+    std::vector<Vertex::Label> orderSix(nSix);
+    for (auto &v : orderSix) {
+        int32_t ix;
+        file.read(reinterpret_cast<char *>(&ix), sizeof(ix));
+        v = vertexAt.at(ix);
+    }
+    for (auto v : vertexAt) if (verticesSix.contains(v)) verticesSix.remove(v);
+    for (auto v : orderSix) verticesSix.add(v);
+    // Comment: pick() draws an element index, so matching element order (plus the
+    // restored rng) reproduces the exact proposal sequence after resume.
+}
+
+void Universe::setSliceTarget(int target) {  // Arms the event-driven slice-volume counters
+    targetSlice2Volume = target;
+    slicesAtTarget = 0; slicesBelow = 0; slicesAbove = 0;
+    if (target <= 0) return;  // Disarmed: counters idle, moves skip the bookkeeping
+    for (auto ss : sliceSizes) {
+        if (ss == target) slicesAtTarget++;
+        else if (ss < target) slicesBelow++;
+        else slicesAbove++;
+    }
+    // Comment: One O(nSlices) scan per arming; move26/move62 keep the buckets exact
+    // afterwards via sliceSizeChanged(), so the volfix loop never rescans (Sec. 2.4).
+}
+
+int Universe::sliceTargetDirection() const {  // Proposal bias for the 2D volfix loop
+    if (slicesAbove == 0) return 1;   // Every slice at/below target: only growth can hit it
+    if (slicesBelow == 0) return -1;  // Every slice at/above target: only shrinking can
+    return 0;                         // Mixed: either direction can reach the target
+}
+
+void Universe::sliceSizeChanged(int time, int oldSize) {  // Rebuckets one slice
+    if (targetSlice2Volume <= 0) return;
+    if (oldSize == targetSlice2Volume) slicesAtTarget--;
+    else if (oldSize < targetSlice2Volume) slicesBelow--;
+    else slicesAbove--;
+    int newSize = sliceSizes[time];
+    if (newSize == targetSlice2Volume) slicesAtTarget++;
+    else if (newSize < targetSlice2Volume) slicesBelow++;
+    else slicesAbove++;
 }
 
 bool Universe::move26(Tetra::Label t) {  // (2,6)-move (Sec. 2.3.1, Fig. 3)
@@ -177,6 +448,8 @@ bool Universe::move26(Tetra::Label t) {  // (2,6)-move (Sec. 2.3.1, Fig. 3)
     tetrasAll.add(tn01); tetrasAll.add(tn12); tetrasAll.add(tn20);
     tetras31.add(tn01); tetras31.add(tn12); tetras31.add(tn20);
     tetrasAll.add(tvn01); tetrasAll.add(tvn12); tetrasAll.add(tvn20);
+    markSpatialDirty(tn01); markSpatialDirty(tn12); markSpatialDirty(tn20);  // Base triangle split in three
+    retireSpatialData(t);  // t's half-edges and triangle die with it
 
     auto to0 = t->getTetraOpposite(v0), to1 = t->getTetraOpposite(v1), to2 = t->getTetraOpposite(v2);  // Old neighbors
     auto tvo0 = tv->getTetraOpposite(v0), tvo1 = tv->getTetraOpposite(v1), tvo2 = tv->getTetraOpposite(v2);
@@ -205,6 +478,7 @@ bool Universe::move26(Tetra::Label t) {  // (2,6)-move (Sec. 2.3.1, Fig. 3)
     slabSizes[time] += 2;  // Update geometry stats
     slabSizes[(time - 1 + nSlices) % nSlices] += 2;
     sliceSizes[time] += 2;
+    sliceSizeChanged(time, sliceSizes[time] - 2);  // Keep the armed slice-target counters exact
 
     tetrasAll.remove(t); tetras31.remove(t); tetrasAll.remove(tv);  // Remove old tetras
     Tetra::destroy(t); Tetra::destroy(tv);
@@ -215,10 +489,19 @@ bool Universe::move26(Tetra::Label t) {  // (2,6)-move (Sec. 2.3.1, Fig. 3)
     v0->scnum++; v1->scnum++; v2->scnum++;  // Update coordination numbers
     v0->cnum += 2; v1->cnum += 2; v2->cnum += 2; vt->cnum += 2; vb->cnum += 2;
 
+    verticesSix.add(vn);  // New vertex starts with cnum 6, scnum 3
+    updateVerticesSix(v0); updateVerticesSix(v1); updateVerticesSix(v2);  // Neighbors may drop out
+    updateVerticesSix(vt); updateVerticesSix(vb);
+
+    markVertexDirty(vn); markVertexDirty(v0); markVertexDirty(v1);  // Adjacency changed around vn
+    markVertexDirty(v2); markVertexDirty(vt); markVertexDirty(vb);
+
+    for (auto x : {tn01, tn12, tn20, tvn01, tvn12, tvn20}) checkFeed(x);  // Incremental consistency window
     return true;  // Move successful
     // HPC Target [GPU #7]: Batch multiple move26 calls on GPU.
 }
 
+template <int S>
 bool Universe::move62(Vertex::Label v) {  // (6,2)-move (Sec. 2.3.1, Fig. 3)
     assert(v->cnum == 6);  // Input must have 6 tetrahedra
     int time = v->time;
@@ -239,9 +522,9 @@ bool Universe::move62(Vertex::Label v) {  // (6,2)-move (Sec. 2.3.1, Fig. 3)
     auto tvo01 = tv01->getTetraOpposite(v), tvo12 = tv12->getTetraOpposite(v), tvo20 = tv20->getTetraOpposite(v);
 
     // Commented-out checks for tadpoles/self-energy (Sec. 1.3); replaced by strictness levels
-    if (strictness == 1) {  // Disallow tadpoles
+    if (S == 1) {  // Disallow tadpoles (compile-time: S mirrors the run-constant strictness)
         if (v0->scnum < 3 || v1->scnum < 3 || v2->scnum < 3) return false;
-    } else if (strictness >= 2) {  // Disallow self-energy
+    } else if (S >= 2) {  // Disallow self-energy
         if (v0->scnum < 4 || v1->scnum < 4 || v2->scnum < 4) return false;
     }
 
@@ -261,6 +544,10 @@ bool Universe::move62(Vertex::Label v) {  // (6,2)-move (Sec. 2.3.1, Fig. 3)
     v0->scnum--; v1->scnum--; v2->scnum--;  // Update coordination numbers
     v0->cnum -= 2; v1->cnum -= 2; v2->cnum -= 2; vt->cnum -= 2; vb->cnum -= 2;
 
+    verticesSix.remove(v);  // v is deleted below; neighbors may become eligible
+    updateVerticesSix(v0); updateVerticesSix(v1); updateVerticesSix(v2);
+    updateVerticesSix(vt); updateVerticesSix(vb);
+
     to01->exchangeTetraOpposite(t01->getVertexOpposite(v), tn);  // Update external neighbors
     to12->exchangeTetraOpposite(t12->getVertexOpposite(v), tn);
     to20->exchangeTetraOpposite(t20->getVertexOpposite(v), tn);
@@ -268,6 +555,12 @@ bool Universe::move62(Vertex::Label v) {  // (6,2)-move (Sec. 2.3.1, Fig. 3)
     tvo12->exchangeTetraOpposite(tv12->getVertexOpposite(v), tvn);
     tvo20->exchangeTetraOpposite(tv20->getVertexOpposite(v), tvn);
 
+    markVertexDirty(v); markVertexDirty(v0); markVertexDirty(v1);  // v disappears from its neighbors
+    markVertexDirty(v2); markVertexDirty(vt); markVertexDirty(vb);
+
+    markSpatialDirty(tn);  // Three base triangles merge into one
+    retireSpatialData(t01); retireSpatialData(t12); retireSpatialData(t20);
+
     tetrasAll.remove(t01); tetrasAll.remove(t12); tetrasAll.remove(t20);  // Remove old tetras
     tetras31.remove(t01); tetras31.remove(t12); tetras31.remove(t20);
     tetrasAll.remove(tv01); tetrasAll.remove(tv12); tetrasAll.remove(tv20);
@@ -277,11 +570,18 @@ bool Universe::move62(Vertex::Label v) {  // (6,2)-move (Sec. 2.3.1, Fig. 3)
     verticesAll.remove(v); Vertex::destroy(v);  // Remove central vertex
 
     slabSizes[time] -= 2; slabSizes[(time - 1 + nSlices) % nSlices] -= 2; sliceSizes[time] -= 2;  // Update stats
+    sliceSizeChanged(time, sliceSizes[time] + 2);  // Keep the armed slice-target counters exact
 
+    for (auto x : {tn, tvn}) checkFeed(x);  // Incremental consistency window
     return true;
     // HPC Target [GPU #7]: Batch move62 calls on GPU.
 }
+template bool Universe::move62<0>(Vertex::Label);  // One instantiation per strictness level
+template bool Universe::move62<1>(Vertex::Label);
+template bool Universe::move62<2>(Vertex::Label);
+template bool Universe::move62<3>(Vertex::Label);
 
+template <int S>
 bool Universe::move44(Tetra::Label t012, Tetra::Label t230) {  // (4,4)-move (Sec. 2.3.2, Fig. 4)
     Vertex::Label v0, v1, v2, v3;  // Identify vertices
     v1 = t012->getVertexOppositeTetra(t230);  // Opposite vertex in t012
@@ -296,9 +596,9 @@ bool Universe::move44(Tetra::Label t012, Tetra::Label t230) {  // (4,4)-move (Se
 
     auto tv012 = t012->tnbr[3], tv230 = t230->tnbr[3];  // Vertical (1,3) neighbors
 
-    if (strictness >= 1 && v1 == v3) return false;  // Prevent degeneracy
-    if (strictness >= 2 && (v0->scnum == 3 || v2->scnum == 3)) return false;  // Prevent self-energy
-    if (strictness >= 3 && v1->neighborsVertex(v3)) return false;  // Prevent existing link (Sec. 2.3.2)
+    if (S >= 1 && v1 == v3) return false;  // Prevent degeneracy (S: compile-time strictness)
+    if (S >= 2 && (v0->scnum == 3 || v2->scnum == 3)) return false;  // Prevent self-energy
+    if (S >= 3 && v1->neighborsVertex(v3)) return false;  // Prevent existing link (Sec. 2.3.2)
 
     auto vt = t012->vs[3], vb = tv012->vs[0];  // Top/bottom vertices
     auto ta01 = t012->getTetraOpposite(v2), ta12 = t012->getTetraOpposite(v0);  // External neighbors
@@ -308,6 +608,12 @@ bool Universe::move44(Tetra::Label t012, Tetra::Label t230) {  // (4,4)-move (Se
 
     if (ta01 == t230 || ta23 == t012 || tva01 == tv230 || tva23 == tv012) return false;  // Prevent tadpoles
 
+    // Capture opposite vertices before rewriting the reused tetras below
+    auto t012vo2 = t012->getVertexOpposite(v2), t230vo0 = t230->getVertexOpposite(v0);
+    auto tv012vo2 = tv012->getVertexOpposite(v2), tv230vo0 = tv230->getVertexOpposite(v0);
+
+    retireSpatialData(t012); retireSpatialData(t230);  // Both base triangles are reshaped by the flip
+
     auto tn013 = t230, tn123 = t012, tvn013 = tv230, tvn123 = tv012;  // Reuse tetras for flip
     tn013->setVertices(v0, v1, v3, vt); tn123->setVertices(v1, v2, v3, vt);  // New vertex sets
     tvn013->setVertices(vb, v0, v1, v3); tvn123->setVertices(vb, v1, v2, v3);
@@ -317,20 +623,30 @@ bool Universe::move44(Tetra::Label t012, Tetra::Label t230) {  // (4,4)-move (Se
     tvn013->setTetras(tn013, tvn123, tva30, tva01);
     tvn123->setTetras(tn123, tva23, tvn013, tva12);
 
-    ta01->exchangeTetraOpposite(t012->getVertexOpposite(v2), tn013);  // Update external neighbors
-    ta23->exchangeTetraOpposite(t230->getVertexOpposite(v0), tn123);
-    tva01->exchangeTetraOpposite(tv012->getVertexOpposite(v2), tvn013);
-    tva23->exchangeTetraOpposite(tv230->getVertexOpposite(v0), tvn123);
+    ta01->exchangeTetraOpposite(t012vo2, tn013);  // Update external neighbors
+    ta23->exchangeTetraOpposite(t230vo0, tn123);
+    tva01->exchangeTetraOpposite(tv012vo2, tvn013);
+    tva23->exchangeTetraOpposite(tv230vo0, tvn123);
 
     v0->scnum--; v1->scnum++; v2->scnum--; v3->scnum++;  // Update spatial coordination
     v0->cnum -= 2; v1->cnum += 2; v2->cnum -= 2; v3->cnum += 2;  // Update total coordination
+    updateVerticesSix(v0); updateVerticesSix(v1); updateVerticesSix(v2); updateVerticesSix(v3);
     v0->tetra = tn013; v2->tetra = tn123;  // Update tetra links
+    markSpatialDirty(tn013); markSpatialDirty(tn123);  // Reused labels carry the flipped triangles
+
+    markVertexDirty(v0); markVertexDirty(v1);  // Flipped edge v0-v2 -> v1-v3
+    markVertexDirty(v2); markVertexDirty(v3);
 
-    if (strictness >= 2) assert(v0->scnum >= 3 && v2->scnum >= 3);  // Validate post-move
+    if (S >= 2) assert(v0->scnum >= 3 && v2->scnum >= 3);  // Validate post-move
 
+    for (auto x : {tn013, tn123, tvn013, tvn123}) checkFeed(x);  // Incremental consistency window
     return true;
     // HPC Target [GPU #7]: Batch move44 calls on GPU.
 }
+template bool Universe::move44<0>(Tetra::Label, Tetra::Label);  // One instantiation per strictness level
+template bool Universe::move44<1>(Tetra::Label, Tetra::Label);
+template bool Universe::move44<2>(Tetra::Label, Tetra::Label);
+template bool Universe::move44<3>(Tetra::Label, Tetra::Label);
 
 bool Universe::move23u(Tetra::Label t31, Tetra::Label t22) {  // (2,3)-move upward (Sec. 2.3.3, Fig. 5)
     Vertex::Label v0 = t31->getVertexOppositeTetra(t22), v1 = t22->getVertexOppositeTetra(t31);
@@ -363,11 +679,17 @@ bool Universe::move23u(Tetra::Label t31, Tetra::Label t22) {  // (2,3)-move upwa
     ta134->exchangeTetraOpposite(t22->getVertexOpposite(v2), tn22r);
 
     v0->cnum += 2; v1->cnum += 2;
+    updateVerticesSix(v0); updateVerticesSix(v1);  // cnum crossed the threshold?
+    markVertexDirty(v0); markVertexDirty(v1);  // New edge v0-v1
+    markVertexDirty(v2); markVertexDirty(v3); markVertexDirty(v4);
+    markSpatialDirty(tn31);  // Same base triangle, fresh tetra label
+    retireSpatialData(t31);
     tetrasAll.remove(t31); tetras31.remove(t31); tetrasAll.remove(t22);
     Tetra::destroy(t31); Tetra::destroy(t22);
 
     tn31->vs[0]->tetra = tn31; tn31->vs[1]->tetra = tn31; tn31->vs[2]->tetra = tn31;
 
+    for (auto x : {tn31, tn22l, tn22r}) checkFeed(x);  // Incremental consistency window
     return true;
     // HPC Target [GPU #7]: Batch move23u calls on GPU.
 }
@@ -393,12 +715,17 @@ bool Universe::move32u(Tetra::Label t31, Tetra::Label t22l, Tetra::Label t22r) {
 
     t31->tnbr[3]->exchangeTetraOpposite(t31->tnbr[3]->vs[0], tn31);
     ta023->exchangeTetraOpposite(t22l->getVertexOpposite(v1), tn31);
-    ta034->exchangeTetraOpposite(t22r->getTetraOpposite(v1), tn31);
+    ta034->exchangeTetraOpposite(t22r->getVertexOpposite(v1), tn31);
     ta123->exchangeTetraOpposite(t22l->getVertexOpposite(v0), tn22);
     ta124->exchangeTetraOpposite(t31->getVertexOpposite(v0), tn22);
-    ta134->exchangeTetraOpposite(t22r->getTetraOpposite(v0), tn22);
+    ta134->exchangeTetraOpposite(t22r->getVertexOpposite(v0), tn22);
 
     v0->cnum -= 2; v1->cnum -= 2;
+    updateVerticesSix(v0); updateVerticesSix(v1);  // cnum crossed the threshold?
+    markVertexDirty(v0); markVertexDirty(v1);  // Edge v0-v1 removed
+    markVertexDirty(v2); markVertexDirty(v3); markVertexDirty(v4);
+    markSpatialDirty(tn31);  // Same base triangle, fresh tetra label
+    retireSpatialData(t31);
     tetrasAll.remove(t31); tetras31.remove(t31); tetrasAll.remove(t22l); tetrasAll.remove(t22r);
     Tetra::destroy(t31); Tetra::destroy(t22l); Tetra::destroy(t22r);
 
@@ -407,6 +734,7 @@ bool Universe::move32u(Tetra::Label t31, Tetra::Label t22l, Tetra::Label t22r) {
 
     tn31->vs[0]->tetra = tn31; tn31->vs[1]->tetra = tn31; tn31->vs[2]->tetra = tn31;
 
+    for (auto x : {tn31, tn22}) checkFeed(x);  // Incremental consistency window
     return true;
     // HPC Target [GPU #7]: Batch move32u calls on GPU.
 }
@@ -439,13 +767,17 @@ bool Universe::move23d(Tetra::Label t13, Tetra::Label t22) {  // (2,3)-move down
     ta023->exchangeTetraOpposite(t13->getVertexOpposite(v4), tn22l);
     ta034->exchangeTetraOpposite(t13->getVertexOpposite(v2), tn22r);
     ta123->exchangeTetraOpposite(t22->getVertexOpposite(v4), tn22l);
-    ta124->exchangeTetraOpposite(t22->getTetraOpposite(v3), tn13);
-    ta134->exchangeTetraOpposite(t22->getTetraOpposite(v2), tn22r);
+    ta124->exchangeTetraOpposite(t22->getVertexOpposite(v3), tn13);
+    ta134->exchangeTetraOpposite(t22->getVertexOpposite(v2), tn22r);
 
     v0->cnum += 2; v1->cnum += 2;
+    updateVerticesSix(v0); updateVerticesSix(v1);  // cnum crossed the threshold?
+    markVertexDirty(v0); markVertexDirty(v1);  // New edge v0-v1
+    markVertexDirty(v2); markVertexDirty(v3); markVertexDirty(v4);
     tetrasAll.remove(t13); tetrasAll.remove(t22);
     Tetra::destroy(t13); Tetra::destroy(t22);
 
+    for (auto x : {tn13, tn22l, tn22r}) checkFeed(x);  // Incremental consistency window
     return true;
     // HPC Target [GPU #7]: Batch move23d calls on GPU.
 }
@@ -471,64 +803,130 @@ bool Universe::move32d(Tetra::Label t13, Tetra::Label t22l, Tetra::Label t22r) {
     tn22->setTetras(tn13, ta124, ta134, ta123);
 
     t13->tnbr[0]->exchangeTetraOpposite(t13->tnbr[0]->vs[3], tn13);
-    ta023->exchangeTetraOpposite(t22l->getTetraOpposite(v1), tn13);
-    ta034->exchangeTetraOpposite(t22r->getTetraOpposite(v1), tn13);
-    ta123->exchangeTetraOpposite(t22l->getTetraOpposite(v0), tn22);
-    ta124->exchangeTetraOpposite(t13->getTetraOpposite(v0), tn22);
-    ta134->exchangeTetraOpposite(t22r->getTetraOpposite(v0), tn22);
+    ta023->exchangeTetraOpposite(t22l->getVertexOpposite(v1), tn13);
+    ta034->exchangeTetraOpposite(t22r->getVertexOpposite(v1), tn13);
+    ta123->exchangeTetraOpposite(t22l->getVertexOpposite(v0), tn22);
+    ta124->exchangeTetraOpposite(t13->getVertexOpposite(v0), tn22);
+    ta134->exchangeTetraOpposite(t22r->getVertexOpposite(v0), tn22);
 
     v0->cnum -= 2; v1->cnum -= 2;
+    updateVerticesSix(v0); updateVerticesSix(v1);  // cnum crossed the threshold?
+    markVertexDirty(v0); markVertexDirty(v1);  // Edge v0-v1 removed
+    markVertexDirty(v2); markVertexDirty(v3); markVertexDirty(v4);
     tetrasAll.remove(t13); tetrasAll.remove(t22l); tetrasAll.remove(t22r);
     Tetra::destroy(t13); Tetra::destroy(t22l); Tetra::destroy(t22r);
 
     int time = tn13->vs[3]->time;
     slabSizes[time] -= 1;
 
+    for (auto x : {tn13, tn22}) checkFeed(x);  // Incremental consistency window
     return true;
     // HPC Target [GPU #7]: Batch move32d calls on GPU.
 }
 
+void Universe::updateVerticesSix(Vertex::Label v) {  // Syncs v's membership in the (6,2) candidate Bag
+    bool eligible = v->cnum == 6 && v->scnum == 3;  // Deletable vertex condition (Sec. 2.3.1)
+    if (eligible && !verticesSix.contains(v)) verticesSix.add(v);
+    else if (!eligible && verticesSix.contains(v)) verticesSix.remove(v);
+}
+
+void Universe::markVertexDirty(Vertex::Label v) {  // Flags v for refresh in updateVertexData()
+    std::lock_guard<std::mutex> lock(dirtyMutex);
+    dirtyVertices.insert(v);  // Set semantics give the dedup; re-inserts are O(1) no-ops
+}
+
+static thread_local Marker<Tetra> visitedT;    // Visited tetras in refreshVertexNeighbors (per replica thread)
+static thread_local Marker<Vertex> visitedV;  // Collected neighbors in refreshVertexNeighbors
+
+void Universe::refreshVertexNeighbors(Vertex::Label v) {  // Recomputes vertexNeighbors[v] (Sec. 3.2.2)
+    std::vector<Vertex::Label> nbr;  // BFS over tetras containing v
+    auto t = v->tetra;
+    std::vector<Tetra::Label> current = {t}, next, done;
+    visitedT.clear(); visitedT.mark(t);
+
+    do {
+        for (auto tc : current) {
+            for (auto tcn : tc->tnbr) {
+                if (!tcn->hasVertex(v)) continue;
+                if (!visitedT.visited(tcn)) {
+                    visitedT.mark(tcn);
+                    done.push_back(tcn);
+                    next.push_back(tcn);
+                }
+            }
+        }
+        current = next;
+        next.clear();
+    } while (current.size() > 0);
+
+    visitedV.clear(); visitedV.mark(v);
+    for (auto td : done) {  // Extract unique neighbors
+        for (auto vd : td->vs) {
+            if (!visitedV.visited(vd)) { visitedV.mark(vd); nbr.push_back(vd); }
+        }
+    }
+    vertexNeighbors[v] = nbr;
+}
+
 void Universe::updateVertexData() {  // Updates vertex connectivity (Sec. 3.2.2)
     vertices.clear();
     int max = 0;
     for (auto v : verticesAll) { vertices.push_back(v); if (v > max) max = v; }  // Collect vertex labels
 
-    vertexNeighbors.clear();
-    vertexNeighbors.resize(max + 1);  // Resize for max label
-
-    for (auto v : verticesAll) {  // BFS to find neighbors
-        std::vector<Vertex::Label> nbr;
-        auto t = v->tetra;
-        std::vector<Tetra::Label> current = {t}, next, done;
-
-        do {
-            for (auto tc : current) {
-                for (auto tcn : tc->tnbr) {
-                    if (!tcn->hasVertex(v)) continue;
-                    if (std::find(done.begin(), done.end(), tcn) == done.end()) {
-                        done.push_back(tcn);
-                        next.push_back(tcn);
-                    }
-                }
-            }
-            current = next;
-            next.clear();
-        } while (current.size() > 0);
+    if (!vertexNeighborsValid) {  // Full rebuild: first call, or fallback after invalidation
+        vertexNeighbors.clear();
+        vertexNeighbors.resize(max + 1);  // Resize for max label
 
-        for (auto td : done) {  // Extract unique neighbors
-            for (auto vd : td->vs) {
-                if (std::find(nbr.begin(), nbr.end(), vd) == nbr.end() && vd != v) nbr.push_back(vd);
-            }
-        }
-        vertexNeighbors[v] = nbr;
+        for (auto v : verticesAll) refreshVertexNeighbors(v);  // BFS to find neighbors
+
+        dirtyVertices.clear();  // Queue is subsumed by the rebuild
+        vertexNeighborsValid = true;
+        vertexCsr.build(vertexNeighbors);  // Repack the staging vectors for BFS consumers
+        return;
     }
+
+    // Incremental path: only vertices flagged by the moves since the last update changed adjacency,
+    // so the work is O(moves since last measurement) instead of O(N0).
+    if (max + 1 > static_cast<int>(vertexNeighbors.size())) vertexNeighbors.resize(max + 1);
+
+    for (Vertex::Label v : dirtyVertices) {
+        if (verticesAll.contains(v)) refreshVertexNeighbors(v);  // Live vertex (label may be reused): recompute
+        else if (v < static_cast<int>(vertexNeighbors.size()))
+            vertexNeighbors[v].clear();  // Vertex was deleted by a (6,2)-move; its label may exceed the live range
+    }
+    dirtyVertices.clear();
+
+    vertexCsr.build(vertexNeighbors);  // Repack: one linear pass, cheap next to the BFS refreshes
+
     // HPC Target [OpenMP #3, GPU #8]: Parallelize BFS for speedup.
 }
 
+void Universe::retireSpatialData(Tetra::Label t) {  // Called by moves before destroying a (3,1)
+    if (!spatialValid) return;   // Structures not built yet; the full rebuild ignores corpses
+    if (t->hes[0] < 0) return;   // Created after the last update; never had spatial data
+    Triangle::destroy(t->hes[0]->triangle);
+    for (int i = 0; i < 3; i++) HalfEdge::destroy(t->hes[i]);
+    // Comment: The flat halfEdges/triangles lists are repacked from tetras31 at
+    // update time, so eager pool destruction here needs no list bookkeeping.
+}
+
+void Universe::markSpatialDirty(Tetra::Label t) {  // Called by moves for each new/reshaped (3,1)
+    t->hes = {-1, -1, -1};  // Pool slots are recycled unscrubbed; invalidate inherited half-edges
+    if (!spatialValid) return;
+    std::lock_guard<std::mutex> lock(dirtyMutex);
+    dirtyTetras31.insert(t);
+}
+
 void Universe::updateHalfEdgeData() {  // Updates half-edge connectivity (Sec. 3.2)
+    if (spatialValid) {  // Incremental path handles half-edges and triangles together
+        updateSpatialStructureIncremental();
+        return;
+    }
+
     for (int i = halfEdges.size() - 1; i >= 0; i--) HalfEdge::destroy(halfEdges[i]);  // Clear old half-edges
-    assert(HalfEdge::size() == 0);
     halfEdges.clear();
+    // Comment: No global-pool emptiness assert here; the arena is shared, so other
+    // replicas' half-edges may be live while this one rebuilds.
 
     for (auto t : tetras31) {  // Create half-edges for (3,1)-tetras
         std::array<HalfEdge::Label, 3> these;
@@ -549,7 +947,7 @@ void Universe::updateHalfEdgeData() {  // Updates half-edge connectivity (Sec. 3
             auto tc = t->getTetraOpposite(v);
             Tetra::Label tn;
             v = vt;
-            while (tc->is22()) {  // Traverse (2,2)-tetras
+            while (Tetra::typeOf(tc) == Tetra::TWOTWO) {  // Traverse (2,2)-tetras (packed type read)
                 tn = tc->getTetraOpposite(v);
                 auto vo = v;
                 v = tc->vs[2] == v ? tc->vs[3] : tc->vs[2];
@@ -563,28 +961,140 @@ void Universe::updateHalfEdgeData() {  // Updates half-edge connectivity (Sec. 3
 }
 
 void Universe::updateTriangleData() {  // Updates triangle connectivity (Sec. 3.2)
+    if (spatialValid) return;  // updateSpatialStructureIncremental() already refreshed triangles
+
     for (int i = triangles.size() - 1; i >= 0; i--) Triangle::destroy(triangles[i]);  // Clear old triangles
     triangles.clear();
 
+    for (auto &l : vertexTriangles) l.clear();  // Reset the incidence index (slots are reused)
+
     for (auto t : tetras31) {  // Create triangles for (3,1)-tetras
         auto tr = Triangle::create();
         tr->setVertices(t->vs[0], t->vs[1], t->vs[2]);
         tr->setHalfEdges(t->hes[0], t->hes[1], t->hes[2]);
         t->hes[0]->triangle = tr; t->hes[1]->triangle = tr; t->hes[2]->triangle = tr;
         triangles.push_back(tr);
+        for (int i = 0; i < 3; i++) {  // Record incidence at the triangle's three vertices
+            if (t->vs[i] >= static_cast<int>(vertexTriangles.size())) vertexTriangles.resize(t->vs[i] + 1);
+            vertexTriangles[t->vs[i]].push_back(tr);
+        }
     }
-    triangleNeighbors.resize(triangles.size());
+    int trmax = 0;  // Maximum live triangle label
+    for (auto tr : triangles) { if (tr > trmax) trmax = tr; }
+    triangleNeighbors.resize(trmax + 1);
+    // Comment: Sized by label, not count; with replicas sharing the Pool arena a
+    // label can exceed this replica's triangle count.
 
     for (auto tr : triangles) {  // Link triangle neighbors
         tr->setTriangleNeighbors(tr->hes[0]->getAdjacent()->triangle, tr->hes[1]->getAdjacent()->triangle, tr->hes[2]->getAdjacent()->triangle);
         triangleNeighbors[tr] = tr->trnbr;
     }
+
+    dirtyTetras31.clear();  // Subsumed by the rebuild
+    spatialValid = true;    // Later updates take the incremental path
+}
+
+void Universe::updateSpatialStructureIncremental() {  // O(moves since last measurement), not O(N31)
+    std::vector<Tetra::Label> fresh;  // Dirty tetras that are still alive
+    for (int d : dirtyTetras31) {
+        Tetra::Label t = d;
+        if (!tetras31.contains(t)) continue;  // Destroyed later in the burst, or a recycled label
+
+        std::array<HalfEdge::Label, 3> these;  // Same construction as the full rebuild
+        for (int i = 0; i < 3; i++) {
+            auto h = HalfEdge::create();
+            h->setVertices(t->vs[i], t->vs[(i + 1) % 3]);
+            h->tetra = t;
+            these[i] = h;
+        }
+        t->setHalfEdges(these[0], these[1], these[2]);
+        for (int i = 0; i < 3; i++) { these[i]->next = these[(i + 1) % 3]; these[i]->prev = these[(i - 1 + 3) % 3]; }
+
+        auto tr = Triangle::create();
+        tr->setVertices(t->vs[0], t->vs[1], t->vs[2]);
+        tr->setHalfEdges(t->hes[0], t->hes[1], t->hes[2]);
+        t->hes[0]->triangle = tr; t->hes[1]->triangle = tr; t->hes[2]->triangle = tr;
+
+        fresh.push_back(t);
+    }
+    dirtyTetras31.clear();
+
+    std::vector<Triangle::Label> touched;  // Triangles whose neighbor rows need refreshing
+    for (auto t : fresh) {  // Relink adjacency across each fresh tetra's three edges
+        for (int i = 0; i < 3; i++) {
+            auto v = t->vs[i], vt = t->vs[3];
+            auto tc = t->getTetraOpposite(v);
+            Tetra::Label tn;
+            v = vt;
+            while (Tetra::typeOf(tc) == Tetra::TWOTWO) {  // Traverse (2,2)-tetras, as in the full rebuild
+                tn = tc->getTetraOpposite(v);
+                v = tc->vs[2] == v ? tc->vs[3] : tc->vs[2];
+                tc = tn;
+            }
+            assert(tc->is31());
+            auto hthis = t->hes[(i + 1) % 3], hthat = tc->getHalfEdgeTo(t->vs[(i + 1) % 3]);
+            hthis->adj = hthat; hthat->adj = hthis;
+            touched.push_back(tc->hes[0]->triangle);  // The partner's row references our new triangle
+        }
+        touched.push_back(t->hes[0]->triangle);
+    }
+
+    halfEdges.clear();  // Repack the flat lists in canonical Bag order
+    triangles.clear();
+    for (auto &l : vertexTriangles) l.clear();  // The incidence index repacks with them
+    int trmax = 0;
+    for (auto t : tetras31) {
+        for (int i = 0; i < 3; i++) halfEdges.push_back(t->hes[i]);
+        auto tr = t->hes[0]->triangle;
+        triangles.push_back(tr);
+        if (tr > trmax) trmax = tr;
+        for (int i = 0; i < 3; i++) {
+            if (t->vs[i] >= static_cast<int>(vertexTriangles.size())) vertexTriangles.resize(t->vs[i] + 1);
+            vertexTriangles[t->vs[i]].push_back(tr);
+        }
+    }
+    if (trmax + 1 > static_cast<int>(triangleNeighbors.size())) triangleNeighbors.resize(trmax + 1);
+
+    for (auto tr : touched) {  // All adj links are final; refresh the affected rows
+        tr->setTriangleNeighbors(tr->hes[0]->getAdjacent()->triangle, tr->hes[1]->getAdjacent()->triangle, tr->hes[2]->getAdjacent()->triangle);
+        triangleNeighbors[tr] = tr->trnbr;
+    }
+    // Comment: An edge only changes if one of its (3,1) endpoints was reshaped, and the
+    // relink writes both sides, so clean tetras keep valid half-edges throughout.
 }
 
 void Universe::updateGeometry() {  // Full geometry update (Sec. 3.2)
     updateVertexData();
     updateHalfEdgeData();
     updateTriangleData();
+
+    frozenSliceSizes = sliceSizes;  // Freeze the move-mutated inputs observables read
+    int vmax = 0;
+    for (auto v : vertices) {
+        if (v > vmax) vmax = v;
+    }
+    if (static_cast<int>(frozenVertexTime.size()) < vmax + 1) {
+        frozenVertexTime.resize(vmax + 1);
+        frozenVertexScnum.resize(vmax + 1);
+    }
+    for (auto v : vertices) {
+        frozenVertexTime[v] = v->time;
+        frozenVertexScnum[v] = v->scnum;
+    }
+    int trmax = 0;
+    for (auto tr : triangles) {
+        if (tr > trmax) trmax = tr;
+    }
+    if (static_cast<int>(frozenTriangleTime.size()) < trmax + 1) frozenTriangleTime.resize(trmax + 1);
+    for (auto tr : triangles) frozenTriangleTime[tr] = tr->time;
+    // Comment: The frozen copies, the label snapshots (vertices, triangles) and
+    // vertexCsr are rebuilt only here, so a measurement stage may overlap the next
+    // sweep if it reads nothing else. The spatial layer itself is NOT stable under
+    // moves: every add/delete/flip retireSpatialData()s its base triangle
+    // mid-sweep, Pool-destroying the triangle and its half-edges (whose next field
+    // doubles as the free-list link). Observables that walk trnbr, vertexTriangles
+    // or half-edge chains must run before the sweep — see the pipelineSafe flag in
+    // observable.hpp, which measureAll() enforces.
 }
 
 void Universe::check() {  // Diagnostic check (Sec. 1.3)
@@ -635,4 +1145,102 @@ void Universe::check() {  // Diagnostic check (Sec. 1.3)
         }
     }
     printf("====================================================\n");
+}
+
+int Universe::checkTetra(Tetra::Label t, std::string &report) {  // One tetra, reported not asserted
+    char line[128];
+    int bad = 0;
+    auto fail = [&](const char *what, int a, int b) {  // One diagnostic line per violation
+        snprintf(line, sizeof(line), "tetra %d: %s (%d, %d)\n", static_cast<int>(t), what, a, b);
+        report += line;
+        bad++;
+    };
+
+    if (!tetrasAll.contains(t)) { fail("not in tetrasAll", t, -1); return bad; }
+
+    for (int i = 0; i < 4; i++) {  // Validate vertices (same constraints as check())
+        if (!verticesAll.contains(t->vs[i])) fail("vertex not in verticesAll", i, t->vs[i]);
+        for (int j = i + 1; j < 4; j++)
+            if (t->vs[i] == t->vs[j]) fail("duplicate vertex", i, j);
+    }
+
+    for (int i = 0; i < 4; i++) {  // Validate neighbors
+        Tetra::Label tn = t->tnbr[i];
+        if (tn < 0 || tn == t) { fail("bad neighbor label", i, tn); continue; }
+        if (!tetrasAll.contains(tn)) { fail("neighbor not in tetrasAll", i, tn); continue; }
+        if (!tn->neighborsTetra(t)) fail("neighbor link not reciprocal", i, tn);
+
+        int sv = 0;
+        for (int j = 0; j < 4; j++) if (t->hasVertex(tn->vs[j])) sv++;
+        if (sv < 3) fail("neighbor shares fewer than 3 vertices", i, tn);
+
+        if (t->is31()) {
+            if (i < 3) { if (!(tn->is31() || tn->is22())) fail("(3,1) side neighbor has wrong type", i, tn); }
+            else if (!tn->is13()) fail("(3,1) vertical neighbor is not (1,3)", i, tn);
+        } else if (t->is13()) {
+            if (i == 0) { if (!tn->is31()) fail("(1,3) vertical neighbor is not (3,1)", i, tn); }
+            else if (!(tn->is13() || tn->is22())) fail("(1,3) side neighbor has wrong type", i, tn);
+        }
+    }
+
+    for (int i = 0; i < 4; i++) {  // Validate opposite consistency
+        Tetra::Label tn = t->tnbr[i];
+        if (t->getTetraOpposite(t->vs[i]) != tn) fail("opposite table mismatch", i, tn);
+        if (tn >= 0 && tn != t && tetrasAll.contains(tn)
+            && tn->getTetraOpposite(t->getVertexOpposite(t->vs[i])) != t)
+            fail("reverse opposite mismatch", i, tn);
+    }
+
+    return bad;
+    // Comment: The per-tetra body of check() with diagnostics instead of asserts;
+    // the three runChecks() tiers and any future tooling share this one routine.
+}
+
+long Universe::runChecks(int mode) {  // Continuous verification driver (see checkMode in universe.hpp)
+    if (mode == 0) mode = checkMode;  // Callers may force a tier (e.g. full after an import)
+    if (mode == 0) return 0;
+    std::string report;
+    long bad = 0;
+
+    if (mode == 1) {  // Incremental: the rolling window of move-touched tetras
+        unsigned head = checkRingHead;  // Sweep threads are joined here; plain load is exact
+        unsigned n = head < static_cast<unsigned>(checkRingLen) ? head : checkRingLen;
+        for (unsigned k = 0; k < n; k++) {
+            Tetra::Label t = checkRingBuf[k].load(std::memory_order_relaxed);  // Workers joined; no writer is live
+            if (!tetrasAll.contains(t)) continue;  // Touched, then deleted by a later move
+            bad += checkTetra(t, report);
+        }
+        checkRingHead = 0;  // Drained; the next sweep refills the window
+    } else if (mode == 2) {  // Sampled: statistical coverage of the bulk
+        for (int k = 0; k < checkSampleSize && tetrasAll.size() > 0; k++)
+            bad += checkTetra(tetrasAll.pick(checkRng), report);
+    } else {  // Full: every tetra plus the vertex constraints, reported not asserted
+        for (auto t : tetrasAll) bad += checkTetra(t, report);
+        char line[128];
+        for (auto v : verticesAll) {
+            if (!tetrasAll.contains(v->tetra)) {
+                snprintf(line, sizeof(line), "vertex %d: tetra hint %d is dead\n",
+                         static_cast<int>(v), static_cast<int>(v->tetra));
+                report += line;
+                bad++;
+            }
+            int minsc = strictness >= 2 ? 3 : (strictness == 1 ? 2 : 0);
+            if (v->scnum < minsc) {
+                snprintf(line, sizeof(line), "vertex %d: scnum %d below strictness bound %d\n",
+                         static_cast<int>(v), v->scnum, minsc);
+                report += line;
+                bad++;
+            }
+        }
+        // Comment: Triangle adjacency (the last check() block) needs the derived
+        // spatial structures, which are only current right after updateGeometry();
+        // mid-sweep they are legitimately stale, so the tiers stop at the core state.
+    }
+
+    if (bad > 0) {
+        checkErrors += bad;
+        printf("consistency check: %ld violation(s)\n%s", bad, report.c_str());
+        fflush(stdout);  // A long unattended job should leave the diagnostics behind
+    }
+    return bad;
 }
\ No newline at end of file
@@ -3,93 +3,258 @@
 // Comment: Standard header guard.
 
 #include <vector>      // For dynamic arrays (e.g., slabSizes)
-#include <random>      // For std::default_random_engine
+#include "rng.hpp"     // For Xoshiro256pp (batched RNG, Sec. 2.1)
+#include <mutex>       // For the dirty-vertex set guard
+#include <atomic>      // For the lock-free checkFeed ring head
+#include <thread>      // For the background export writer
 #include <string>      // For std::string (e.g., fID)
+#include <unordered_set> // For the dirty-vertex set
 #include "vertex.hpp"  // Vertex class for vertices
 #include "halfedge.hpp" // HalfEdge class (likely for connectivity)
 #include "triangle.hpp" // Triangle class (sub-simplices)
 #include "tetra.hpp"   // Tetra class for tetrahedra
 #include "pool.hpp"    // Pool template for O(1) memory management (Sec. 3.1.1)
 #include "bag.hpp"     // Bag template for random selection (Sec. 3.1.2)
+#include "csr.hpp"     // FlatAdjacency CSR storage for BFS traversals (Sec. 3.2.2)
 
 // Comment: Universe manages the 3D CDT triangulation state (Sec. 3 of paper).
 
 class Universe {
+private:
+    Xoshiro256pp rng;  // Random number generator for this replica
+    // Comment: Declared first so the Bag members below can bind their reference.
+    // HPC Target [MPI #4]: Per-instance engines make distributed runs independent.
+
 public:
-    static int nSlices;  // Number of spatial slices (S^1 direction, Sec. 2.3)
+    Universe();  // Sets up an empty engine; initialize() loads a geometry into it
+    // Comment: One instance per replica; instances share only the Pool arena (Sec. 3.1.1).
+    ~Universe() { finishExports(); }  // Joins a still-running background export
+
+    int nSlices = 0;  // Number of spatial slices (S^1 direction, Sec. 2.3)
     // Comment: Tracks time slices in S^1 x S^2 topology.
 
-    static std::vector<int> slabSizes;  // Sizes of slabs (tetrahedra between slices)
-    static std::vector<int> sliceSizes; // Sizes of spatial slices (S^2 topology)
+    std::vector<int> slabSizes;  // Sizes of slabs (tetrahedra between slices)
+    std::vector<int> sliceSizes; // Sizes of spatial slices (S^2 topology)
     // Comment: Store geometric data for volume profile (Sec. 3.4).
 
-    static std::string fID;      // File identifier for output
-    static std::string OutFile;  // Output geometry file name
+    void setSliceTarget(int target);  // Arms the slice-volume counters below (one O(nSlices) scan)
+    bool sliceAtTarget() const { return slicesAtTarget > 0; }  // Some slice sits at the target size
+    int sliceTargetDirection() const;  // +1: all slices at/below target, -1: all at/above, 0: mixed
+    // Comment: Event-driven 2D volume targeting for Simulation (Sec. 2.4). Only
+    // move26/move62 change slice sizes, so those moves keep the counters exact and
+    // the volfix loop tests a flag instead of rescanning sliceSizes per attempt.
+
+    std::string fID;      // File identifier for output
+    std::string OutFile;  // Output geometry file name
     // Comment: Used for I/O (Sec. 3.3).
 
-    static int strictness;      // Manifold strictness level (Sec. 1.3)
-    static int volfix_switch;   // Toggle for volume fixing (Sec. 2.4)
+    int strictness;      // Manifold strictness level (Sec. 1.3)
+    int volfix_switch;   // Toggle for volume fixing (Sec. 2.4)
     // Comment: Configuration parameters from main.cpp.
 
-    static Bag<Tetra, Tetra::pool_size> tetrasAll;  // All tetrahedra
-    static Bag<Tetra, Tetra::pool_size> tetras31;  // All (3,1)-tetrahedra
-    static Bag<Vertex, Vertex::pool_size> verticesAll;  // All vertices
-    static Bag<Vertex, Vertex::pool_size> verticesSix;  // Vertices with six tetrahedra
+    Bag<Tetra> tetrasAll;  // All tetrahedra
+    Bag<Tetra> tetras31;  // All (3,1)-tetrahedra
+    Bag<Vertex> verticesAll;  // All vertices
+    Bag<Vertex> verticesSix;  // Vertices with six tetrahedra
     // Comment: Bags enable O(1) random selection (Sec. 3.1.2). 'tetras31' for (2,6)-move, 'verticesSix' for (6,2)-move (Sec. 2.3.1).
+    // Sized from the run-time Pool capacities (config pool keys), not compile-time constants.
     // HPC Target [General #10]: Large memory footprint; optimize with contiguous storage.
 
-    static bool initialize(std::string geometryFilename, std::string fID, int strictness, int volfix_switch);
+    bool initialize(std::string geometryFilename, std::string fID, int strictness, int volfix_switch);
     // Comment: Sets up initial triangulation (Sec. 3.1), optionally loading from file. Returns success status.
+    // Accepts both the text format and the binary ".bcdt" format (detected by magic tag, loaded via mmap).
     // HPC Target [General #10]: Pre-allocate Pools/Bags for cache efficiency.
 
-    static bool exportGeometry(std::string geometryFilename);
+    static void reset() {  // Returns the shared simplex arena to pristine state
+        Pool<Vertex>::reset();
+        Pool<Tetra>::reset();
+        Pool<HalfEdge>::reset();
+        Pool<Triangle>::reset();
+    }
+    // Comment: Between sequential runs in one process (the batch driver in
+    // main.cpp): O(capacity) free-list rebuild instead of process teardown and
+    // relaunch, keeping the backed chunks resident. The Bags and every other
+    // per-run structure live inside the Universe instance and come up pristine
+    // with the next one; every live Label dies here, so all Universes (and the
+    // Simulations bound to them) must be destroyed first.
+
+    bool exportGeometry(std::string geometryFilename);
     // Comment: Saves triangulation to file (Sec. 3). Returns success status.
+    // Writes the binary format when the filename ends in ".bcdt", the text format otherwise.
+
+    void exportGeometryAsync(std::string geometryFilename);
+    // Comment: Like exportGeometry(), but only the in-memory snapshot is taken on the
+    // calling thread; formatting and the disk write run on a background writer thread,
+    // so the sweep loop resumes immediately. At most one write is in flight.
+
+    void finishExports();
+    // Comment: Joins a pending background write. Call before reading the output file
+    // or letting the process exit.
+
+    void canonicalizeState();
+    // Comment: Re-derives the per-vertex tetra hints by the same rule initialize()
+    // uses and invalidates the adjacency staging. v->tetra (the move62 / BFS entry
+    // point) and the vertexNeighbors element order are move-history artifacts the
+    // geometry file does not carry; writeCheckpoint() applies this to the live run
+    // so its future trajectory matches what a resumed run reconstructs.
+
+    void compactGeometry();
+    // Comment: Renumbers this replica's tetras and vertices in breadth-first order
+    // from a deterministic seed, reusing the slots it already owns in ascending
+    // order. After millions of create()/destroy() cycles the free list scatters
+    // adjacent simplices across the Pool chunks, turning every tnbr hop in moves
+    // and in the BFS observables into a random DRAM access; the relabeling makes
+    // dual-graph neighbors near-contiguous again. Bag memberships are refilled in
+    // BFS order (a pure function of the geometry, so resumed runs stay aligned)
+    // and the adjacency/spatial staging is invalidated for a full rebuild. Called
+    // by Simulation at the thermalization/measurement boundary and periodically
+    // during measurements.
+
+    void saveCheckpointState(std::ostream &file);
+    void restoreCheckpointState(std::istream &file);
+    // Comment: Checkpoint hooks for Simulation (Sec. 3.3). The geometry file
+    // canonicalizes verticesAll/tetrasAll order on reload, but tetras31 and
+    // verticesSix were filled in move order, so their element order (which the
+    // pick() index maps through) is saved as permutations and reimposed on
+    // resume, together with the Bag rng. This keeps a resumed run's proposal
+    // sequence identical to the uninterrupted one.
 
-    static bool move26(Tetra::Label t);  // (2,6)-move (add move, Sec. 2.3.1)
-    static bool move62(Vertex::Label v); // (6,2)-move (delete move, Sec. 2.3.1)
+    bool move26(Tetra::Label t);  // (2,6)-move (add move, Sec. 2.3.1)
+    template <int S> bool move62(Vertex::Label v); // (6,2)-move (delete move, Sec. 2.3.1)
     // Comment: Add/delete moves modify volume (Fig. 3). Return success status.
     // HPC Target [GPU #7]: Batch move attempts on GPU for speedup.
 
-    static bool move44(Tetra::Label t123, Tetra::Label t134);  // (4,4)-move (flip move, Sec. 2.3.2)
+    template <int S> bool move44(Tetra::Label t123, Tetra::Label t134);  // (4,4)-move (flip move, Sec. 2.3.2)
     // Comment: Flips spatial edge (Fig. 4). Takes two (3,1)-tetrahedra as input.
+    // Comment: S is the strictness level, a compile-time copy of the runtime member:
+    // it is fixed for the whole run, so the manifold checks it gates are folded out
+    // of the per-attempt hot path. Instantiated for S = 0..3 in universe.cpp;
+    // Simulation::bindMoveKernels() dispatches to the right instantiation once.
 
-    static bool move23u(Tetra::Label t31, Tetra::Label t22);  // (2,3)-move upward (shift, Sec. 2.3.3)
-    static bool move32u(Tetra::Label t31, Tetra::Label t22l, Tetra::Label t22r);  // (3,2)-move upward (ishift)
-    static bool move23d(Tetra::Label t13, Tetra::Label t22);  // (2,3)-move downward
-    static bool move32d(Tetra::Label t13, Tetra::Label t22l, Tetra::Label t22r);  // (3,2)-move downward
+    bool move23u(Tetra::Label t31, Tetra::Label t22);  // (2,3)-move upward (shift, Sec. 2.3.3)
+    bool move32u(Tetra::Label t31, Tetra::Label t22l, Tetra::Label t22r);  // (3,2)-move upward (ishift)
+    bool move23d(Tetra::Label t13, Tetra::Label t22);  // (2,3)-move downward
+    bool move32d(Tetra::Label t13, Tetra::Label t22l, Tetra::Label t22r);  // (3,2)-move downward
     // Comment: Shift/ishift moves adjust interpolation between slices (Fig. 5). 'u'/'d' denote direction.
     // HPC Target [GPU #7]: Parallelize move attempts across tetrahedra.
 
-    static void updateVertexData();    // Updates Vertex data (e.g., cnum, Sec. 3.2.2)
-    static void updateHalfEdgeData();  // Updates HalfEdge data
-    static void updateTriangleData();  // Updates Triangle data
-    // Comment: Maintains geometric consistency post-move (Sec. 3.2).
+    void markVertexDirty(Vertex::Label v);  // Flags v for adjacency refresh in updateVertexData()
+    // Comment: Called by the move routines for every vertex whose neighborhood they touch (Sec. 3.2.2).
 
-    static void updateGeometry();  // Full geometry update
+    void updateVertexData();    // Updates Vertex data (e.g., cnum, Sec. 3.2.2)
+    void updateHalfEdgeData();  // Updates HalfEdge data
+    void updateTriangleData();  // Updates Triangle data
+    // Comment: Maintains geometric consistency post-move (Sec. 3.2). Half-edge and
+    // triangle data switch to the incremental path once built: only (3,1)-tetras
+    // reshaped since the last update (dirtyTetras31) are recreated and relinked,
+    // since shift moves leave the spatial slices untouched and add/delete/flip
+    // moves touch a bounded neighborhood. The full rebuild remains the first-call
+    // and fallback path.
+
+    void updateGeometry();  // Full geometry update
     // Comment: Likely calls above updates; prepares for measurements (Sec. 3.2).
 
-    static std::vector<Vertex::Label> vertices;            // All vertex labels
-    static std::vector<Tetra::Label> tetras;              // All tetra labels
-    static std::vector<HalfEdge::Label> halfEdges;        // All half-edge labels
-    static std::vector<Triangle::Label> triangles;        // All triangle labels
+    std::vector<Vertex::Label> vertices;            // All vertex labels
+    std::vector<Tetra::Label> tetras;              // All tetra labels
+    std::vector<HalfEdge::Label> halfEdges;        // All half-edge labels
+    std::vector<Triangle::Label> triangles;        // All triangle labels
     // Comment: Store full simplex lists for reconstruction (Sec. 3.2).
     // HPC Target [General #10]: Pre-allocate to avoid resizing.
 
-    static std::vector<std::vector<Vertex::Label>> vertexNeighbors;       // Vertex adjacency lists
-    static std::vector<std::array<Triangle::Label, 3>> triangleNeighbors; // Triangle adjacency (3 neighbors each)
-    // Comment: Reconstructed connectivity for measurements (Sec. 3.2.2).
+    std::vector<int> frozenSliceSizes;    // sliceSizes as of the last updateGeometry()
+    std::vector<int> frozenVertexTime;    // Per-label vertex time, same snapshot
+    std::vector<int> frozenVertexScnum;   // Per-label spatial coordination number
+    std::vector<int> frozenTriangleTime;  // Per-label triangle time
+    // Comment: Frozen together with the derived connectivity at the end of
+    // updateGeometry(). Moves never touch the derived structures, but they do mutate
+    // sliceSizes and the per-vertex fields; observables read these frozen copies
+    // instead, so a measurement stage sees one coherent snapshot and can run
+    // concurrently with the next sweep (pipelined mode, simulation.cpp).
+
+    std::vector<std::vector<Vertex::Label>> vertexNeighbors;       // Vertex adjacency staging
+    FlatAdjacency<Vertex::Label> vertexCsr;                        // Packed vertex adjacency for BFS
+    std::vector<std::array<Triangle::Label, 3>> triangleNeighbors; // Triangle adjacency (3 neighbors each)
+    std::vector<std::vector<Triangle::Label>> vertexTriangles;     // Vertex -> incident slice triangles
+    // Comment: Incidence index rebuilt with the triangle data, indexed by vertex label.
+    // Turns Minbu's neck verification and BFS seeding into O(degree) lookups instead
+    // of full tetras31/triangles scans (Sec. 3.4). The (3,1)-tetra behind a triangle
+    // is reachable as tr->hes[0]->tetra, so this one index covers vertex->tetra31 too.
+    // Comment: Reconstructed connectivity for measurements (Sec. 3.2.2). The per-vertex
+    // vectors are the mutable staging area maintained by updateVertexData(); observables
+    // traverse vertexCsr, repacked from it in one pass after each update.
     // HPC Target [OpenMP #3, GPU #8]: Used in BFS; parallelize construction/use.
 
-    static void check();  // Validates triangulation (e.g., manifold properties, Sec. 1.3)
-    // Comment: Debugging/diagnostic tool.
+    void check();  // Validates triangulation (e.g., manifold properties, Sec. 1.3)
+    // Comment: Debugging/diagnostic tool. All-or-nothing: one O(N3) pass with hard
+    // asserts; see checkMode below for the continuous low-overhead alternative.
+
+    // Tiered consistency checking (optional "checkmode" config key): 0 off,
+    // 1 incremental (moves feed their new/reshaped tetras into a small ring,
+    // validated at the end of each sweep), 2 sampled ("checksample" random tetras
+    // per sweep), 3 full (every tetra and vertex per sweep). Unlike check(),
+    // violations are printed and counted in checkErrors instead of asserted, so a
+    // long unattended job keeps running and leaves diagnostics in its log.
+    int checkMode = 0;         // Set from the config in main.cpp
+    int checkSampleSize = 64;  // Tetras per sweep in sampled mode ("checksample" key)
+    long checkErrors = 0;      // Total violations runChecks() has found
+    void checkFeed(Tetra::Label t) {  // Moves record touched tetras (mode 1 only)
+        if (checkMode != 1) return;
+        unsigned h = checkRingHead.fetch_add(1, std::memory_order_relaxed);
+        checkRingBuf[h & (checkRingLen - 1)].store(t, std::memory_order_relaxed);
+        // Comment: Old entries are overwritten, so mode 1 verifies the most
+        // recently touched simplices — the ones a buggy move would corrupt —
+        // at a cost independent of sweep length; sampled mode covers the bulk.
+        // Head and slots are atomic because moves run on concurrent sweep
+        // threads when nThreads > 1; a relaxed fetch_add claims each slot, and
+        // two threads lapping the ring into the same slot merely drop one
+        // diagnostic entry — benign for a rolling window, and defined behavior
+        // for the same reason the Bags' lock-free reads use atomic ints.
+    }
+    long runChecks(int mode = 0);  // Sweep-end dispatch (0 = use checkMode); returns new violations
+    int checkTetra(Tetra::Label t, std::string &report);  // One tetra's constraints; appends diagnostics
 
 private:
-    Universe() {}  // Private constructor; enforces static-only usage
-    // Comment: Singleton-like design; all members static (Sec. 3).
+    static const int checkRingLen = 1024;  // Power of two; a rolling window of touched tetras
+    std::array<std::atomic<int>, checkRingLen> checkRingBuf;  // Labels only; validated when the state is consistent
+    std::atomic<unsigned> checkRingHead{0};  // Monotonic; min(head, len) entries are live
+    Xoshiro256pp checkRng{0x5eed};  // Sampled mode draws here, not from the move stream's rng
+    // Comment: A separate engine so enabling checks never perturbs the trajectory;
+    // results with checkmode on are bit-identical to the same run without it.
+
+    std::unordered_set<int> dirtyVertices;  // Vertices flagged by moves since last updateVertexData()
+    // Comment: A per-universe set rather than a flag on the shared Vertex pool, so label
+    // recycling across replicas cannot lose or leak dirty markings.
+    bool vertexNeighborsValid = false;  // False until the first full rebuild of vertexNeighbors
+    // Comment: Together these make updateVertexData() O(moves since last measurement) instead of O(N0).
+
+    void refreshVertexNeighbors(Vertex::Label v);  // Recomputes vertexNeighbors[v] via local BFS
+
+    std::unordered_set<int> dirtyTetras31;  // (3,1)-tetras created or reshaped since the last spatial update
+    bool spatialValid = false;  // False until the first full half-edge/triangle rebuild
+    // Comment: Same pattern as dirtyVertices: per-universe set keyed by label, checked
+    // against tetras31 at update time so recycled labels cannot resurrect stale entries.
+
+    void retireSpatialData(Tetra::Label t);   // Destroys a doomed (3,1)-tetra's half-edges and triangle
+    void markSpatialDirty(Tetra::Label t);    // Flags a new/reshaped (3,1)-tetra for recreation
+    void updateSpatialStructureIncremental(); // Recreates and relinks only the dirty tetras
+
+    std::mutex dirtyMutex;    // Serializes dirty-set pushes from concurrent sweep threads
+    std::thread exportWriter; // Background geometry export writer (at most one in flight)
+
+    int targetSlice2Volume = 0;  // Armed slice-size target (0: counters idle)
+    int slicesAtTarget = 0;      // Slices whose size equals the target
+    int slicesBelow = 0;         // Slices strictly below the target
+    int slicesAbove = 0;         // Slices strictly above the target
+    void sliceSizeChanged(int time, int oldSize);  // Rebuckets one slice after move26/move62
+    // Comment: Maintained incrementally (two compares per add/delete move), so the
+    // measurement-time volfix loop costs O(1) per attempt regardless of nSlices.
+
+    void updateVerticesSix(Vertex::Label v);  // Adds/removes v from verticesSix after a cnum/scnum change
+    // Comment: Keeps the (6,2)-move candidate Bag exact, so moveDelete() proposals never miss (Sec. 2.3.1).
 
-    static std::default_random_engine rng;  // Random number generator
-    // Comment: Used for move selection (Sec. 2.1).
-    // HPC Target [MPI #4]: Needs per-rank instances for distributed runs.
+    std::vector<int> buildGeometryRecords();  // Snapshot phase of export: the full record sequence
+    static void writeGeometryRecords(const std::vector<int> &dat, std::string geometryFilename);  // Stateless; runs on the writer thread
+    // Comment: Write phase of export; formats records as binary or text by filename extension.
 };
 
 // HPC Targets Summary:
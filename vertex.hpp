@@ -12,9 +12,9 @@ class Vertex : public Pool<Vertex> {  // Vertex inherits from Pool for memory ma
 // Comment: Represents a vertex in the 3D CDT triangulation (Sec. 3.2.2). Inherits from Pool to manage instances efficiently (Sec. 3.1.1).
 
 public:
-    static const unsigned pool_size = 3000000;  // Maximum number of vertices in Pool
-    // Comment: Defines capacity C for Pool (Sec. 3.1.1), set to 3 million vertices. Limits memory usage but caps system size.
-    // HPC Target [General #10]: Fixed size could be pre-allocated for cache efficiency, but consider dynamic sizing for larger systems.
+    static const unsigned pool_size = 3000000;  // Default vertex capacity (Sec. 3.1.1)
+    // Comment: Used when the config file sets no "maxvertices" key; Pool storage is
+    // chunked and demand-allocated, so the default costs nothing until slots are used.
 
     int time;  // Slice number
     // Comment: Discrete time label τ for the spatial slice containing this vertex (Sec. 2.3). For S^1 x S^2 topology, vertices are ordered by time.
@@ -30,6 +30,8 @@ public:
     // Comment: Label of an arbitrary (3,1)-tetrahedron with this vertex in its base (not apex) (Sec. 3.2.2, Fig. 7). Default -1 indicates unassigned.
     // Purpose: Starting point for neighborhood reconstruction (Sec. 3.2.2). Label type is an alias from Pool<Tetra>.
 
+    // Purpose: Lets updateVertexData() rebuild only the vertices touched since the last measurement.
+
     bool neighborsVertex(Vertex::Label v);
     // Comment: Checks if vertex 'v' is a neighbor of this vertex (connected by an edge).
     // Usage: Likely used in move validation (e.g., flip move, Sec. 2.3.2) or observable calculations (Sec. 3.4).